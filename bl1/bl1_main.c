@@ -10,6 +10,7 @@
 #include <auth_mod.h>
 #include <bl1.h>
 #include <bl_common.h>
+#include <boot_profile.h>
 #include <console.h>
 #include <debug.h>
 #include <errata_report.h>
@@ -152,6 +153,8 @@ void bl1_main(void)
 	else
 		NOTICE("BL1-FWU: *******FWU Process Started*******\n");
 
+	BOOT_PROF_REPORT();
+
 	bl1_prepare_next_image(image_id);
 
 	console_flush();
@@ -16,6 +16,127 @@
 #include <stdint.h>
 #include "bl2_private.h"
 
+#if BL2_PIPELINED_LOAD
+/* Image authenticated while the next image is loaded, or NULL */
+static const bl_load_info_node_t *pending_node;
+#endif
+
+/*******************************************************************************
+ * Let the platform handle the information of a loaded image.
+ ******************************************************************************/
+static void bl2_post_image_load(const bl_load_info_node_t *node_info)
+{
+	int err;
+
+	err = bl2_plat_handle_post_image_load(node_info->image_id);
+	if (err) {
+		ERROR("BL2: Failure in post image load handling (%i)\n", err);
+		plat_error_handler(err);
+	}
+}
+
+#if BL2_PIPELINED_LOAD
+/*******************************************************************************
+ * Return 1 if the image can be authenticated while the next image is loaded,
+ * which is only the case if the next image has the IMAGE_ATTRIB_PIPELINE
+ * attribute and is loaded without doing the platform setup first.
+ ******************************************************************************/
+static int bl2_defer_auth(const bl_load_info_node_t *node_info)
+{
+	const bl_load_info_node_t *next = node_info->next_load_info;
+	uint32_t attr;
+
+	if (next == NULL)
+		return 0;
+
+	attr = next->image_info->h.attr;
+	if ((attr & (IMAGE_ATTRIB_SKIP_LOADING | IMAGE_ATTRIB_PLAT_SETUP)) != 0)
+		return 0;
+
+	return ((attr & IMAGE_ATTRIB_PIPELINE) != 0) ? 1 : 0;
+}
+
+/*******************************************************************************
+ * Finish the authentication of a pipelined image. If it fails, the image is
+ * loaded again sequentially, which also tries the other boot sources.
+ ******************************************************************************/
+static void bl2_finish_pipelined_image(const bl_load_info_node_t *node_info)
+{
+	int err;
+
+	err = auth_image_pipelined_finish();
+	if (err) {
+		WARN("BL2: Reloading image id %d (%i)\n", node_info->image_id,
+		     err);
+		err = load_auth_image(node_info->image_id,
+				      node_info->image_info);
+		if (err) {
+			ERROR("BL2: Failed to load image (%i)\n", err);
+			plat_error_handler(err);
+		}
+	}
+}
+
+/*******************************************************************************
+ * Load an image while the hash of the pending image, if any, is calculated
+ * each time the storage driver waits for data. The pending image is then
+ * authenticated and post-processed. The authentication of the new image is
+ * either completed immediately or deferred until the next image is loaded.
+ ******************************************************************************/
+static void bl2_load_image_pipelined(const bl_load_info_node_t *node_info)
+{
+	int err;
+
+	err = load_image_pipelined(node_info->image_id, node_info->image_info);
+
+	if (pending_node != NULL) {
+		bl2_finish_pipelined_image(pending_node);
+		bl2_post_image_load(pending_node);
+		pending_node = NULL;
+	}
+
+	if (err) {
+		/* Load the image again with the usual error handling */
+		WARN("BL2: Reloading image id %d (%i)\n", node_info->image_id,
+		     err);
+		err = load_auth_image(node_info->image_id,
+				      node_info->image_info);
+		if (err) {
+			ERROR("BL2: Failed to load image (%i)\n", err);
+			plat_error_handler(err);
+		}
+		return;
+	}
+
+	auth_image_pipelined_start(node_info->image_id, node_info->image_info);
+	if (bl2_defer_auth(node_info) != 0) {
+		pending_node = node_info;
+	} else {
+		bl2_finish_pipelined_image(node_info);
+	}
+}
+#endif /* BL2_PIPELINED_LOAD */
+
+/*******************************************************************************
+ * Load and authenticate an image.
+ ******************************************************************************/
+static void bl2_load_image(const bl_load_info_node_t *node_info)
+{
+	int err;
+
+#if BL2_PIPELINED_LOAD
+	if ((pending_node != NULL) || (bl2_defer_auth(node_info) != 0)) {
+		bl2_load_image_pipelined(node_info);
+		return;
+	}
+#endif
+
+	err = load_auth_image(node_info->image_id, node_info->image_info);
+	if (err) {
+		ERROR("BL2: Failed to load image (%i)\n", err);
+		plat_error_handler(err);
+	}
+}
 
 /*******************************************************************************
  * This function loads SCP_BL2/BL3x images and returns the ep_info for
@@ -63,27 +184,33 @@ struct entry_point_info *bl2_load_images(void)
 
 		if (!(bl2_node_info->image_info->h.attr & IMAGE_ATTRIB_SKIP_LOADING)) {
 			INFO("BL2: Loading image id %d\n", bl2_node_info->image_id);
-			err = load_auth_image(bl2_node_info->image_id,
-				bl2_node_info->image_info);
-			if (err) {
-				ERROR("BL2: Failed to load image (%i)\n", err);
-				plat_error_handler(err);
-			}
+			bl2_load_image(bl2_node_info);
 		} else {
 			INFO("BL2: Skip loading image id %d\n", bl2_node_info->image_id);
 		}
 
-		/* Allow platform to handle image information. */
-		err = bl2_plat_handle_post_image_load(bl2_node_info->image_id);
-		if (err) {
-			ERROR("BL2: Failure in post image load handling (%i)\n", err);
-			plat_error_handler(err);
+#if BL2_PIPELINED_LOAD
+		/*
+		 * The image is post-processed once it has been authenticated,
+		 * after the next image has been loaded.
+		 */
+		if (pending_node == bl2_node_info) {
+			bl2_node_info = bl2_node_info->next_load_info;
+			continue;
 		}
+#endif
+
+		/* Allow platform to handle image information. */
+		bl2_post_image_load(bl2_node_info);
 
 		/* Go to next image */
 		bl2_node_info = bl2_node_info->next_load_info;
 	}
 
+#if BL2_PIPELINED_LOAD
+	assert(pending_node == NULL);
+#endif
+
 	/*
 	 * Get information to pass to the next image.
 	 */
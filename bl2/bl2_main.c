@@ -9,6 +9,7 @@
 #include <bl1.h>
 #include <bl2.h>
 #include <bl_common.h>
+#include <boot_profile.h>
 #include <console.h>
 #include <debug.h>
 #include <platform.h>
@@ -46,6 +47,8 @@ void bl2_main(void)
 	/* Load the subsequent bootloader images. */
 	next_bl_ep_info = bl2_load_images();
 
+	BOOT_PROF_REPORT();
+
 #if !BL2_AT_EL3
 #ifdef AARCH32
 	/*
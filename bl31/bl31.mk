@@ -36,6 +36,13 @@ ifeq (${ENABLE_PMF}, 1)
 BL31_SOURCES		+=	lib/pmf/pmf_main.c
 endif
 
+ifeq (${ENABLE_SMC_LATENCY_HIST},1)
+ifeq (${ENABLE_PMF},0)
+  $(error ENABLE_PMF must be 1 for ENABLE_SMC_LATENCY_HIST)
+endif
+BL31_SOURCES		+=	bl31/smc_latency_hist.c
+endif
+
 ifeq (${EL3_EXCEPTION_HANDLING},1)
 BL31_SOURCES		+=	bl31/ehf.c
 endif
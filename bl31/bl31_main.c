@@ -9,6 +9,7 @@
 #include <assert.h>
 #include <bl31.h>
 #include <bl_common.h>
+#include <boot_profile.h>
 #include <console.h>
 #include <context_mgmt.h>
 #include <debug.h>
@@ -117,6 +118,8 @@ void bl31_main(void)
 	 */
 	bl31_prepare_next_image_entry();
 
+	BOOT_PROF_REPORT();
+
 	console_flush();
 
 	/*
@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2018, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * Per-CPU histograms of the time spent in EL3 handling each SMC, exported
+ * through PMF.
+ */
+
+#include <arch_helpers.h>
+#include <cpu_data.h>
+#include <platform.h>
+#include <platform_def.h>
+#include <pmf.h>
+#include <smc_latency_hist.h>
+#include <string.h>
+
+typedef struct smc_hist_slot {
+	unsigned long long count;
+	unsigned long long sum;
+	unsigned long long max;
+	uint32_t fid;
+	uint32_t buckets[SMC_HIST_BUCKETS];
+} smc_hist_slot_t;
+
+/*
+ * Only the owning CPU updates its histograms. Other CPUs request a reset by
+ * setting the `reset` flag, which the owning CPU acts upon before recording
+ * its next SMC.
+ */
+typedef struct smc_hist {
+	smc_hist_slot_t slots[SMC_HIST_SLOTS];
+	unsigned int used_slots;
+	volatile unsigned int reset;
+} __aligned(CACHE_WRITEBACK_GRANULE) smc_hist_t;
+
+static smc_hist_t smc_hist[PLATFORM_CORE_COUNT];
+
+/*
+ * Record the duration of the SMC that has just been handled on this CPU. The
+ * EL3 entry time-stamp is captured in per-cpu data by the exception vector.
+ */
+void smc_latency_hist_record(uint32_t smc_fid)
+{
+	unsigned long long delta;
+	smc_hist_t *hist = &smc_hist[plat_my_core_pos()];
+	smc_hist_slot_t *slot;
+	unsigned int i, bucket = 0U;
+
+	delta = read_cntpct_el0() -
+		get_cpu_data(cpu_data_pmf_ts[CPU_DATA_PMF_TS0_IDX]);
+
+	if (hist->reset != 0U) {
+		(void)memset(hist->slots, 0, sizeof(hist->slots));
+		hist->used_slots = 0U;
+		hist->reset = 0U;
+	}
+
+	for (i = 0U; i < hist->used_slots; i++) {
+		if (hist->slots[i].fid == smc_fid)
+			break;
+	}
+
+	if (i == hist->used_slots) {
+		if (i < SMC_HIST_SLOT_OTHER) {
+			hist->slots[i].fid = smc_fid;
+			hist->used_slots++;
+		} else {
+			i = SMC_HIST_SLOT_OTHER;
+			hist->slots[i].fid = SMC_HIST_FID_OTHER;
+		}
+	}
+
+	if (delta != 0ULL) {
+		bucket = 64U - (unsigned int)__builtin_clzll(delta);
+		if (bucket >= SMC_HIST_BUCKETS)
+			bucket = SMC_HIST_BUCKETS - 1U;
+	}
+
+	slot = &hist->slots[i];
+	slot->count++;
+	slot->sum += delta;
+	if (delta > slot->max)
+		slot->max = delta;
+	slot->buckets[bucket]++;
+}
+
+/*
+ * PMF time-stamp retrieval handler. The histograms are only accessed by EL3 on
+ * CPUs whose caches are hardware coherent, so the PMF_CACHE_MAINT flag is
+ * ignored.
+ */
+static unsigned long long smc_latency_hist_get(unsigned int tid,
+		u_register_t mpidr,
+		unsigned int flags)
+{
+	int cpu_idx = plat_core_pos_by_mpidr(mpidr);
+	unsigned int slot_idx = (tid & SMC_HIST_SLOT_MASK) >> SMC_HIST_SLOT_SHIFT;
+	unsigned int field = (tid & PMF_TID_MASK) >> PMF_TID_SHIFT;
+	smc_hist_t *hist;
+	smc_hist_slot_t *slot;
+
+	if ((cpu_idx < 0) || (slot_idx >= SMC_HIST_SLOTS))
+		return 0ULL;
+
+	hist = &smc_hist[cpu_idx];
+	if (field == SMC_HIST_RESET) {
+		hist->reset = 1U;
+		return 0ULL;
+	}
+
+	/* Histograms waiting to be reset read as empty */
+	if (hist->reset != 0U)
+		return 0ULL;
+
+	slot = &hist->slots[slot_idx];
+	switch (field) {
+	case SMC_HIST_FID:
+		return slot->fid;
+	case SMC_HIST_COUNT:
+		return slot->count;
+	case SMC_HIST_SUM:
+		return slot->sum;
+	case SMC_HIST_MAX:
+		return slot->max;
+	default:
+		if ((field >= SMC_HIST_BUCKET(0)) &&
+		    (field < SMC_HIST_BUCKET(SMC_HIST_BUCKETS)))
+			return slot->buckets[field - SMC_HIST_BUCKET(0)];
+		return 0ULL;
+	}
+}
+
+PMF_REGISTER_SERVICE_SMC_OWN(smc_latency_hist, PMF_ARM_TIF_IMPL_ID,
+	PMF_SMC_LATENCY_SVC_ID, SMC_HIST_TOTAL_IDS, NULL,
+	smc_latency_hist_get)
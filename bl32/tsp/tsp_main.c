@@ -347,6 +347,18 @@ tsp_args_t *tsp_smc_handler(uint64_t func,
 	tsp_stats[linear_id].smc_count++;
 	tsp_stats[linear_id].eret_count++;
 
+	/*
+	 * The null service does no work and returns the times at which it
+	 * started and finished, so that the cost of a call to the TSP can be
+	 * measured and broken down.
+	 */
+	if (TSP_BARE_FID(func) == TSP_NULL) {
+		uint64_t enter_ts = read_cntpct_el0();
+
+		return set_smc_args(func, 0, enter_ts, read_cntpct_el0(),
+				    0, 0, 0, 0);
+	}
+
 	INFO("TSP: cpu 0x%lx received %s smc 0x%llx\n", read_mpidr(),
 		((func >> 31) & 1) == 1 ? "fast" : "yielding",
 		func);
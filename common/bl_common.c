@@ -9,8 +9,11 @@
 #include <assert.h>
 #include <auth_mod.h>
 #include <bl_common.h>
+#include <boot_profile.h>
+#include <cdefs.h>
 #include <debug.h>
 #include <errno.h>
+#include <image_decompress.h>
 #include <io_storage.h>
 #include <platform.h>
 #include <string.h>
@@ -228,15 +231,68 @@ size_t get_image_size(unsigned int image_id)
 
 #if LOAD_IMAGE_V2
 
+#if STREAM_IMAGE_HASH
+/*
+ * Size of the chunks in which an image is read while its hash is calculated.
+ * Each chunk should fit in the data cache so that it is hashed right after
+ * being loaded, without being fetched again from main memory.
+ */
+#ifndef PLAT_STREAM_HASH_CHUNK_SIZE
+#define PLAT_STREAM_HASH_CHUNK_SIZE	U(0x4000)
+#endif
+
+/*******************************************************************************
+ * Function to read an image from the IO layer while the authentication module
+ * calculates its hash. The image is read in chunks, each of them being hashed
+ * as soon as it has been loaded. If the image is not authenticated by its hash,
+ * it is read in a single call to io_read().
+ ******************************************************************************/
+static int read_image_hashed(unsigned int image_id, uintptr_t image_handle,
+			     uintptr_t image_base, size_t image_size,
+			     size_t *bytes_read)
+{
+	size_t chunk_size, chunk_read;
+	size_t total_read = 0;
+	int io_result = 0;
+
+	if ((dyn_is_auth_disabled() != 0) ||
+	    (auth_mod_hash_stream_start(image_id, (void *)image_base) != 0)) {
+		return io_read(image_handle, image_base, image_size,
+			       bytes_read);
+	}
+
+	while (total_read < image_size) {
+		chunk_size = MIN(image_size - total_read,
+				 (size_t)PLAT_STREAM_HASH_CHUNK_SIZE);
+		io_result = io_read(image_handle, image_base + total_read,
+				    chunk_size, &chunk_read);
+		if ((io_result != 0) || (chunk_read == 0)) {
+			break;
+		}
+
+		auth_mod_hash_stream_update((void *)(image_base + total_read),
+					    chunk_read);
+		total_read += chunk_read;
+	}
+
+	auth_mod_hash_stream_finish(total_read);
+	*bytes_read = total_read;
+
+	return io_result;
+}
+#endif /* STREAM_IMAGE_HASH */
+
 /*******************************************************************************
  * Internal function to load an image at a specific address given
- * an image ID and extents of free memory.
+ * an image ID and extents of free memory. When 'hash_on_load' is 0, the image
+ * is not hashed while it is read even if STREAM_IMAGE_HASH is enabled.
  *
  * If the load is successful then the image information is updated.
  *
  * Returns 0 on success, a negative error code otherwise.
  ******************************************************************************/
-static int load_image(unsigned int image_id, image_info_t *image_data)
+static int load_image(unsigned int image_id, image_info_t *image_data,
+		      int hash_on_load)
 {
 	uintptr_t dev_handle;
 	uintptr_t image_handle;
@@ -289,7 +345,26 @@ static int load_image(unsigned int image_id, image_info_t *image_data)
 
 	/* We have enough space so load the image now */
 	/* TODO: Consider whether to try to recover/retry a partially successful read */
+#if STREAM_IMAGE_HASH
+	if (hash_on_load != 0) {
+		io_result = read_image_hashed(image_id, image_handle,
+					      image_base, image_size,
+					      &bytes_read);
+	} else {
+		io_result = io_read(image_handle, image_base, image_size,
+				    &bytes_read);
+	}
+#elif STREAM_IMAGE_DECOMPRESS && defined(IMAGE_BL2)
+	if (image_decompress_is_streamed(image_data) != 0) {
+		io_result = image_decompress_read(image_handle, image_data,
+						  image_size, &bytes_read);
+	} else {
+		io_result = io_read(image_handle, image_base, image_size,
+				    &bytes_read);
+	}
+#else
 	io_result = io_read(image_handle, image_base, image_size, &bytes_read);
+#endif
 	if ((io_result != 0) || (bytes_read < image_size)) {
 		WARN("Failed to load image id=%u (%i)\n", image_id, io_result);
 		goto exit;
@@ -313,6 +388,7 @@ static int load_auth_image_internal(unsigned int image_id,
 				    image_info_t *image_data,
 				    int is_parent_image)
 {
+	uint64_t load_start __unused;
 	int rc;
 
 #if TRUSTED_BOARD_BOOT
@@ -330,18 +406,25 @@ static int load_auth_image_internal(unsigned int image_id,
 	}
 #endif /* TRUSTED_BOARD_BOOT */
 
-	/* Load the image */
-	rc = load_image(image_id, image_data);
+	/* Load the image, hashing it on the way if possible */
+	BOOT_PROF_START(load_start);
+	rc = load_image(image_id, image_data, 1);
 	if (rc != 0) {
 		return rc;
 	}
+	BOOT_PROF_END(BOOT_PROF_IMAGE_LOAD, load_start, image_data->image_size);
 
 #if TRUSTED_BOARD_BOOT
 	if (dyn_is_auth_disabled() == 0) {
+		uint64_t auth_start __unused;
+
 		/* Authenticate it */
+		BOOT_PROF_START(auth_start);
 		rc = auth_mod_verify_img(image_id,
 					 (void *)image_data->image_base,
 					 image_data->image_size);
+		BOOT_PROF_END(BOOT_PROF_IMAGE_AUTH, auth_start,
+			      image_data->image_size);
 		if (rc != 0) {
 			/* Authentication error, zero memory and flush it right away. */
 			zero_normalmem((void *)image_data->image_base,
@@ -386,6 +469,141 @@ int load_auth_image(unsigned int image_id, image_info_t *image_data)
 	return err;
 }
 
+#if BL2_PIPELINED_LOAD && defined(IMAGE_BL2)
+/*
+ * Image loaded by load_image_pipelined() whose hash is calculated while the
+ * next image is read. 'hashed' is the size of the data hashed so far.
+ */
+static struct {
+	unsigned int image_id;
+	image_info_t *image_data;
+	size_t hashed;
+	int streamed;
+} pipeline;
+
+/*******************************************************************************
+ * Hash the next chunk of the pipelined image. This is called by the storage
+ * drivers through io_idle() while they wait for the data of the next image.
+ * Returns 0 once the whole image has been hashed.
+ ******************************************************************************/
+static int pipeline_hash_chunk(void)
+{
+	image_info_t *image_data = pipeline.image_data;
+	size_t chunk_size;
+
+	if ((pipeline.streamed == 0) ||
+	    (pipeline.hashed == image_data->image_size)) {
+		return 0;
+	}
+
+	chunk_size = MIN(image_data->image_size - pipeline.hashed,
+			 (size_t)PLAT_STREAM_HASH_CHUNK_SIZE);
+	auth_mod_hash_stream_update(
+			(void *)(image_data->image_base + pipeline.hashed),
+			chunk_size);
+	pipeline.hashed += chunk_size;
+
+	return 1;
+}
+
+/*******************************************************************************
+ * Load and authenticate the parent images of an image, then load the image
+ * without authenticating it. The image passed to auth_image_pipelined_start(),
+ * if any, is hashed while these images are read. The authentication of the
+ * new image is started with auth_image_pipelined_start() once the previous one
+ * has been finished.
+ ******************************************************************************/
+int load_image_pipelined(unsigned int image_id, image_info_t *image_data)
+{
+	uint64_t load_start __unused;
+	unsigned int parent_id;
+	int rc;
+
+	rc = auth_mod_get_parent_id(image_id, &parent_id);
+	if ((rc == 0) && (dyn_is_auth_disabled() == 0)) {
+		rc = load_auth_image_internal(parent_id, image_data, 1);
+		if (rc != 0) {
+			return rc;
+		}
+	}
+
+	BOOT_PROF_START(load_start);
+	rc = load_image(image_id, image_data, 0);
+	if (rc != 0) {
+		return rc;
+	}
+	BOOT_PROF_END(BOOT_PROF_IMAGE_LOAD, load_start, image_data->image_size);
+
+	return 0;
+}
+
+/*******************************************************************************
+ * Start the authentication of an image loaded by load_image_pipelined(). If
+ * the image is authenticated by its hash, the hash is calculated by the IO
+ * layer idle handler until auth_image_pipelined_finish() is called.
+ ******************************************************************************/
+void auth_image_pipelined_start(unsigned int image_id,
+				image_info_t *image_data)
+{
+	assert(pipeline.image_data == NULL);
+
+	pipeline.image_id = image_id;
+	pipeline.image_data = image_data;
+	pipeline.hashed = 0U;
+	pipeline.streamed = 0;
+	if ((dyn_is_auth_disabled() == 0) &&
+	    (auth_mod_hash_stream_start(image_id,
+					(void *)image_data->image_base) == 0)) {
+		pipeline.streamed = 1;
+	}
+
+	if (pipeline.streamed != 0) {
+		io_register_idle_handler(pipeline_hash_chunk);
+	}
+}
+
+/*******************************************************************************
+ * Hash the rest of the image started with auth_image_pipelined_start() and
+ * authenticate it. Returns 0 on success and -EAUTH otherwise, in which case the
+ * image has been zeroed and must be loaded again.
+ ******************************************************************************/
+int auth_image_pipelined_finish(void)
+{
+	image_info_t *image_data = pipeline.image_data;
+	uint64_t auth_start __unused;
+	int rc = 0;
+
+	assert(image_data != NULL);
+
+	BOOT_PROF_START(auth_start);
+	if (pipeline.streamed != 0) {
+		io_register_idle_handler(NULL);
+		while (pipeline_hash_chunk() != 0)
+			;
+		auth_mod_hash_stream_finish(pipeline.hashed);
+	}
+	pipeline.image_data = NULL;
+
+	if (dyn_is_auth_disabled() == 0) {
+		rc = auth_mod_verify_img(pipeline.image_id,
+					 (void *)image_data->image_base,
+					 image_data->image_size);
+	}
+	BOOT_PROF_END(BOOT_PROF_IMAGE_AUTH, auth_start, image_data->image_size);
+	if (rc != 0) {
+		zero_normalmem((void *)image_data->image_base,
+			       image_data->image_size);
+		flush_dcache_range(image_data->image_base,
+				   image_data->image_size);
+		return -EAUTH;
+	}
+
+	flush_dcache_range(image_data->image_base, image_data->image_size);
+
+	return 0;
+}
+#endif /* BL2_PIPELINED_LOAD && defined(IMAGE_BL2) */
+
 #else /* LOAD_IMAGE_V2 */
 
 /*******************************************************************************
@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2018, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <arch_helpers.h>
+#include <assert.h>
+#include <boot_profile.h>
+#include <debug.h>
+
+/*
+ * The boot profiler accumulates, for each probe, how many times it was hit,
+ * the total and worst case number of system counter ticks spent in it and
+ * how many bytes it processed. It is only meant to be used during cold boot
+ * on the primary CPU, so no locking is done.
+ */
+typedef struct boot_prof_entry {
+	uint32_t count;
+	uint64_t total_ticks;
+	uint64_t max_ticks;
+	uint64_t bytes;
+} boot_prof_entry_t;
+
+static boot_prof_entry_t boot_prof_entries[BOOT_PROF_TOTAL_IDS];
+
+static const char *const boot_prof_names[BOOT_PROF_TOTAL_IDS] = {
+	[BOOT_PROF_IMAGE_LOAD]		= "image_load",
+	[BOOT_PROF_IMAGE_AUTH]		= "image_auth",
+	[BOOT_PROF_DECOMPRESS]		= "decompress",
+	[BOOT_PROF_XLAT_INIT]		= "xlat_init",
+	[BOOT_PROF_GPT_LOAD]		= "gpt_load",
+	[BOOT_PROF_FIP_OPEN]		= "fip_open",
+	[BOOT_PROF_VERIFY_SIGNATURE]	= "verify_signature",
+	[BOOT_PROF_VERIFY_HASH]		= "verify_hash",
+	[BOOT_PROF_XLAT_MAP]		= "xlat_map",
+};
+
+#if defined(IMAGE_BL1)
+#define BOOT_PROF_IMAGE_NAME	"BL1"
+#elif defined(IMAGE_BL2)
+#define BOOT_PROF_IMAGE_NAME	"BL2"
+#elif defined(IMAGE_BL2U)
+#define BOOT_PROF_IMAGE_NAME	"BL2U"
+#elif defined(IMAGE_BL31)
+#define BOOT_PROF_IMAGE_NAME	"BL31"
+#elif defined(IMAGE_BL32)
+#define BOOT_PROF_IMAGE_NAME	"BL32"
+#else
+#define BOOT_PROF_IMAGE_NAME	"BL"
+#endif
+
+uint64_t boot_prof_timestamp(void)
+{
+	isb();
+	return read_cntpct_el0();
+}
+
+void boot_prof_record(unsigned int id, uint64_t start, size_t bytes)
+{
+	boot_prof_entry_t *entry;
+	uint64_t ticks;
+
+	assert(id < BOOT_PROF_TOTAL_IDS);
+
+	ticks = boot_prof_timestamp() - start;
+	entry = &boot_prof_entries[id];
+
+	entry->count++;
+	entry->total_ticks += ticks;
+	if (ticks > entry->max_ticks)
+		entry->max_ticks = ticks;
+	entry->bytes += bytes;
+}
+
+/*******************************************************************************
+ * Print one line per probe that was hit, in a fixed comma separated format so
+ * that it can be extracted from the boot log by scripts:
+ *
+ *   BOOTPROF,<image>,<probe>,<count>,<total ticks>,<max ticks>,<bytes>,<freq>
+ *
+ * where <freq> is the frequency of the system counter in Hz.
+ ******************************************************************************/
+void boot_prof_report(void)
+{
+	unsigned int i;
+	unsigned long freq = read_cntfrq_el0();
+	const boot_prof_entry_t *entry;
+
+	for (i = 0U; i < BOOT_PROF_TOTAL_IDS; i++) {
+		entry = &boot_prof_entries[i];
+		if (entry->count == 0U)
+			continue;
+
+		NOTICE("BOOTPROF,%s,%s,%u,%llu,%llu,%llu,%lu\n",
+		       BOOT_PROF_IMAGE_NAME, boot_prof_names[i], entry->count,
+		       (unsigned long long)entry->total_ticks,
+		       (unsigned long long)entry->max_ticks,
+		       (unsigned long long)entry->bytes, freq);
+	}
+}
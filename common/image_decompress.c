@@ -7,15 +7,32 @@
 #include <arch_helpers.h>
 #include <assert.h>
 #include <bl_common.h>
+#include <boot_profile.h>
+#include <cdefs.h>
 #include <debug.h>
 #include <image_decompress.h>
+#include <io_storage.h>
 #include <stdint.h>
+#include <utils_def.h>
 
 static uintptr_t decompressor_buf_base;
 static uint32_t decompressor_buf_size;
 static decompressor_t *decompressor;
 static struct image_info saved_image_info;
 
+#if STREAM_IMAGE_DECOMPRESS
+/*
+ * Size of the chunks in which a compressed image is read. Each chunk should fit
+ * in the data cache so that it is decompressed right after being loaded.
+ */
+#ifndef PLAT_STREAM_DECOMPRESS_CHUNK_SIZE
+#define PLAT_STREAM_DECOMPRESS_CHUNK_SIZE	U(0x4000)
+#endif
+
+static const decompressor_stream_t *stream_decompressor;
+static const struct image_info *stream_image_info;
+#endif
+
 void image_decompress_init(uintptr_t buf_base, uint32_t buf_size,
 			   decompressor_t *_decompressor)
 {
@@ -24,8 +41,109 @@ void image_decompress_init(uintptr_t buf_base, uint32_t buf_size,
 	decompressor = _decompressor;
 }
 
+#if STREAM_IMAGE_DECOMPRESS
+/*
+ * Decompress the images while they are read, instead of loading them into a
+ * temporary buffer first. Only PLAT_STREAM_DECOMPRESS_CHUNK_SIZE bytes of the
+ * buffer hold compressed data, the rest is the workspace of the decompressor.
+ */
+void image_decompress_init_stream(uintptr_t buf_base, uint32_t buf_size,
+				  const decompressor_stream_t *_decompressor)
+{
+	assert(buf_size > PLAT_STREAM_DECOMPRESS_CHUNK_SIZE);
+
+	decompressor_buf_base = buf_base;
+	decompressor_buf_size = buf_size;
+	stream_decompressor = _decompressor;
+}
+
+int image_decompress_is_streamed(const struct image_info *info)
+{
+	return (stream_image_info != NULL) && (stream_image_info == info);
+}
+
+/*
+ * Read a compressed image of 'image_size' bytes from 'image_handle' and
+ * decompress it to its destination, one chunk at a time. On success, the size
+ * of the decompressed image is stored in info->image_size.
+ */
+int image_decompress_read(uintptr_t image_handle, struct image_info *info,
+			  size_t image_size, size_t *bytes_read)
+{
+	uintptr_t chunk_base = decompressor_buf_base;
+	uintptr_t work_base = chunk_base + PLAT_STREAM_DECOMPRESS_CHUNK_SIZE;
+	uint32_t work_size = decompressor_buf_size -
+			     PLAT_STREAM_DECOMPRESS_CHUNK_SIZE;
+	uintptr_t image_end = info->image_base;
+	size_t chunk_size, chunk_read;
+	size_t total_read = 0;
+	uint64_t start __unused;
+	int io_result = 0;
+	int ret, finish_ret;
+
+	assert(image_decompress_is_streamed(info) != 0);
+	stream_image_info = NULL;
+
+	ret = stream_decompressor->start(info->image_base,
+					 info->image_max_size,
+					 work_base, work_size);
+	if (ret != 0) {
+		ERROR("Failed to decompress image (err=%d)\n", ret);
+		return ret;
+	}
+
+	while (total_read < image_size) {
+		chunk_size = MIN(image_size - total_read,
+				 (size_t)PLAT_STREAM_DECOMPRESS_CHUNK_SIZE);
+		io_result = io_read(image_handle, chunk_base, chunk_size,
+				    &chunk_read);
+		if ((io_result != 0) || (chunk_read == 0)) {
+			break;
+		}
+		total_read += chunk_read;
+
+		BOOT_PROF_START(start);
+		ret = stream_decompressor->update(chunk_base, chunk_read);
+		BOOT_PROF_END(BOOT_PROF_DECOMPRESS, start, chunk_read);
+		if (ret != 0) {
+			break;
+		}
+	}
+
+	finish_ret = stream_decompressor->finish(&image_end);
+	if (ret == 0) {
+		ret = finish_ret;
+	}
+
+	*bytes_read = total_read;
+	if (io_result != 0) {
+		return io_result;
+	}
+	if (ret != 0) {
+		ERROR("Failed to decompress image (err=%d)\n", ret);
+		return ret;
+	}
+
+	info->image_size = image_end - info->image_base;
+	flush_dcache_range(info->image_base, info->image_size);
+
+	return 0;
+}
+#endif /* STREAM_IMAGE_DECOMPRESS */
+
 void image_decompress_prepare(struct image_info *info)
 {
+#if STREAM_IMAGE_DECOMPRESS
+	/*
+	 * The image is decompressed by image_decompress_read() while it is
+	 * loaded, straight to its final destination.
+	 */
+	if (stream_decompressor != NULL) {
+		stream_image_info = info;
+		return;
+	}
+#endif
+
 	/*
 	 * If the image is compressed, it should be loaded into the temporary
 	 * buffer instead of its final destination.  We save image_info, then
@@ -41,8 +159,16 @@ int image_decompress(struct image_info *info)
 {
 	uintptr_t compressed_image_base, image_base, work_base;
 	uint32_t compressed_image_size, work_size;
+	uint64_t start __unused;
 	int ret;
 
+#if STREAM_IMAGE_DECOMPRESS
+	/* The image has been decompressed while it was loaded */
+	if (stream_decompressor != NULL) {
+		return 0;
+	}
+#endif
+
 	/*
 	 * The size of compressed data has been filled by load_image().
 	 * Read it out before restoring image_info.
@@ -62,9 +188,11 @@ int image_decompress(struct image_info *info)
 	work_base = compressed_image_base + compressed_image_size;
 	work_size = decompressor_buf_size - compressed_image_size;
 
+	BOOT_PROF_START(start);
 	ret = decompressor(&compressed_image_base, compressed_image_size,
 			   &image_base, info->image_max_size,
 			   work_base, work_size);
+	BOOT_PROF_END(BOOT_PROF_DECOMPRESS, start, compressed_image_size);
 	if (ret) {
 		ERROR("Failed to decompress image (err=%d)\n", ret);
 		return ret;
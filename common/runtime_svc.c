@@ -7,8 +7,11 @@
 #include <assert.h>
 #include <debug.h>
 #include <errno.h>
+#include <platform.h>
+#include <platform_def.h>
 #include <runtime_svc.h>
 #include <string.h>
+#include <utils_def.h>
 
 /*******************************************************************************
  * The 'rt_svc_descs' array holds the runtime service descriptors exported by
@@ -24,6 +27,145 @@ uint8_t rt_svc_descs_indices[MAX_RT_SVCS];
 #define RT_SVC_DECS_NUM		((RT_SVC_DESCS_END - RT_SVC_DESCS_START)\
 					/ sizeof(rt_svc_desc_t))
 
+#if SMCCC_MAJOR_VERSION == 1
+/*******************************************************************************
+ * The 'rt_svc_fid_descs' array holds the runtime service function descriptors
+ * exported by services by placing them in the 'rt_svc_fid_descs' linker
+ * section. They are looked up through a two level table before falling back
+ * to the per-OEN service descriptor:
+ *
+ * - 'rt_svc_fid_tables_map' is indexed by the unique oen of the SMC and holds
+ *   the index of the dispatch table covering that oen, or an invalid index.
+ *
+ * - 'rt_svc_fid_indices' is indexed by the dispatch table, then by the SMC
+ *   calling convention[30] bit and function number[15:0] combined together.
+ *   It holds the index of a descriptor in the 'rt_svc_fid_descs' array, or an
+ *   invalid index if the SMC must be handled by the service descriptor.
+ ******************************************************************************/
+uint8_t rt_svc_fid_tables_map[MAX_RT_SVCS];
+uint8_t rt_svc_fid_indices[RT_SVC_FID_TABLES][RT_SVC_FID_TABLE_ENTRIES];
+
+#define RT_SVC_FID_DECS_NUM	((RT_SVC_FID_DESCS_END - RT_SVC_FID_DESCS_START)\
+					/ sizeof(rt_svc_fid_desc_t))
+
+/* Index of a function ID in a dispatch table */
+#define get_fid_table_entry(fid)					\
+	(((uint32_t)(fid) & FUNCID_NUM_MASK) |				\
+	((((uint32_t)(fid) >> FUNCID_CC_SHIFT) & FUNCID_CC_MASK) <<	\
+	 RT_SVC_FID_NUM_ENTRIES_LOG2))
+
+/*******************************************************************************
+ * Returns the index in the 'rt_svc_fid_descs' array of the function descriptor
+ * registered for smc_fid, or a negative value if there is none.
+ ******************************************************************************/
+static int get_rt_svc_fid_desc_index(uint32_t smc_fid)
+{
+	unsigned int table;
+
+	if ((smc_fid & FUNCID_NUM_MASK) >= RT_SVC_FID_NUM_ENTRIES)
+		return -1;
+
+	table = rt_svc_fid_tables_map[get_unique_oen_from_smc_fid(smc_fid)];
+	if (table >= RT_SVC_FID_TABLES)
+		return -1;
+
+	return (int8_t)rt_svc_fid_indices[table][get_fid_table_entry(smc_fid)];
+}
+#endif /* SMCCC_MAJOR_VERSION */
+
+#if ENABLE_SMC_STAT
+/*******************************************************************************
+ * Per-CPU SMC call counters. Function IDs registered in a dispatch table have
+ * a counter of their own. All other SMCs are accounted per unique oen, after
+ * the counters of the dispatch tables.
+ ******************************************************************************/
+#define RT_SVC_STAT_OEN_BASE	(RT_SVC_FID_TABLES * RT_SVC_FID_TABLE_ENTRIES)
+#define RT_SVC_STAT_ENTRIES	(RT_SVC_STAT_OEN_BASE + MAX_RT_SVCS)
+
+static uint32_t rt_svc_stat[PLATFORM_CORE_COUNT][RT_SVC_STAT_ENTRIES]
+	__aligned(CACHE_WRITEBACK_GRANULE);
+
+static unsigned int get_rt_svc_stat_index(uint32_t smc_fid)
+{
+#if SMCCC_MAJOR_VERSION == 1
+	unsigned int idx = get_unique_oen_from_smc_fid(smc_fid);
+	unsigned int table;
+
+	if ((smc_fid & FUNCID_NUM_MASK) < RT_SVC_FID_NUM_ENTRIES) {
+		table = rt_svc_fid_tables_map[idx];
+		if (table < RT_SVC_FID_TABLES)
+			return (table * RT_SVC_FID_TABLE_ENTRIES) +
+				get_fid_table_entry(smc_fid);
+	}
+#elif SMCCC_MAJOR_VERSION == 2
+	unsigned int idx = get_rt_desc_idx(GET_SMC_OEN(smc_fid),
+			(smc_fid >> FUNCID_NAMESPACE_SHIFT) & 1U);
+#endif
+
+	return RT_SVC_STAT_OEN_BASE + idx;
+}
+
+/*******************************************************************************
+ * Account for an SMC issued on the calling CPU. This is called by the SMC
+ * handler before dispatching the call.
+ ******************************************************************************/
+void runtime_svc_stat_count(uint32_t smc_fid)
+{
+	unsigned int cpu_idx = plat_my_core_pos();
+
+	assert(cpu_idx < PLATFORM_CORE_COUNT);
+	rt_svc_stat[cpu_idx][get_rt_svc_stat_index(smc_fid)]++;
+}
+
+/*******************************************************************************
+ * Returns the number of times smc_fid has been called on all the CPUs. For an
+ * SMC that is not registered in a dispatch table, this is the number of calls
+ * to all the function IDs sharing its oen and call type.
+ ******************************************************************************/
+uint64_t runtime_svc_stat_get_count(uint32_t smc_fid)
+{
+	unsigned int i, idx = get_rt_svc_stat_index(smc_fid);
+	uint64_t count = 0;
+
+	for (i = 0; i < PLATFORM_CORE_COUNT; i++)
+		count += rt_svc_stat[i][idx];
+
+	return count;
+}
+
+/*******************************************************************************
+ * Prints the SMC call counts gathered so far on all the CPUs.
+ ******************************************************************************/
+void runtime_svc_stat_print(void)
+{
+	unsigned int i, idx;
+	uint64_t count;
+
+	for (idx = 0; idx < RT_SVC_STAT_ENTRIES; idx++) {
+		count = 0;
+		for (i = 0; i < PLATFORM_CORE_COUNT; i++)
+			count += rt_svc_stat[i][idx];
+
+		if (count == 0)
+			continue;
+
+		if (idx < RT_SVC_STAT_OEN_BASE) {
+			NOTICE("SMC table %u, %s function 0x%x: %llu calls\n",
+				idx / RT_SVC_FID_TABLE_ENTRIES,
+				(((idx % RT_SVC_FID_TABLE_ENTRIES) >>
+				  RT_SVC_FID_NUM_ENTRIES_LOG2) == SMC_64) ?
+				"SMC64" : "SMC32",
+				idx % RT_SVC_FID_NUM_ENTRIES,
+				(unsigned long long)count);
+		} else {
+			NOTICE("SMC service 0x%x: %llu calls\n",
+				idx - RT_SVC_STAT_OEN_BASE,
+				(unsigned long long)count);
+		}
+	}
+}
+#endif /* ENABLE_SMC_STAT */
+
 /*******************************************************************************
  * Function to invoke the registered `handle` corresponding to the smc_fid in
  * AArch32 mode.
@@ -38,21 +180,35 @@ uintptr_t handle_runtime_svc(uint32_t smc_fid,
 	int index;
 	unsigned int idx;
 	const rt_svc_desc_t *rt_svc_descs;
+	const rt_svc_fid_desc_t *rt_svc_fid_descs;
+	rt_svc_handle_t smc_handler;
 
 	assert(handle);
 	idx = get_unique_oen_from_smc_fid(smc_fid);
 	assert(idx < MAX_RT_SVCS);
 
-	index = rt_svc_descs_indices[idx];
-	if (index < 0 || index >= (int)RT_SVC_DECS_NUM)
-		SMC_RET1(handle, SMC_UNK);
+	/* Look for a leaf handler of this function ID first */
+	index = get_rt_svc_fid_desc_index(smc_fid);
+	if (index >= 0) {
+		assert(index < (int)RT_SVC_FID_DECS_NUM);
+		rt_svc_fid_descs = (rt_svc_fid_desc_t *) RT_SVC_FID_DESCS_START;
+		smc_handler = rt_svc_fid_descs[index].handle;
+	} else {
+		index = rt_svc_descs_indices[idx];
+		if (index < 0 || index >= (int)RT_SVC_DECS_NUM)
+			SMC_RET1(handle, SMC_UNK);
 
-	rt_svc_descs = (rt_svc_desc_t *) RT_SVC_DESCS_START;
+		rt_svc_descs = (rt_svc_desc_t *) RT_SVC_DESCS_START;
+		smc_handler = rt_svc_descs[index].handle;
+	}
+
+#if ENABLE_SMC_STAT
+	runtime_svc_stat_count(smc_fid);
+#endif
 
 	get_smc_params_from_ctx(handle, x1, x2, x3, x4);
 
-	return rt_svc_descs[index].handle(smc_fid, x1, x2, x3, x4, cookie,
-						handle, flags);
+	return smc_handler(smc_fid, x1, x2, x3, x4, cookie, handle, flags);
 }
 #endif /* SMCCC_MAJOR_VERSION */
 
@@ -86,6 +242,94 @@ static int32_t validate_rt_svc_desc(const rt_svc_desc_t *desc)
 	return 0;
 }
 
+#if SMCCC_MAJOR_VERSION == 1
+/*******************************************************************************
+ * Simple routine to sanity check a runtime service function descriptor before
+ * using it
+ ******************************************************************************/
+static int32_t validate_rt_svc_fid_desc(const rt_svc_fid_desc_t *desc)
+{
+	if (desc == NULL)
+		return -EINVAL;
+
+	if (desc->handle == NULL)
+		return -EINVAL;
+
+	/* The range must be covered by a single dispatch table */
+	if ((desc->start_fid & ~FUNCID_NUM_MASK) !=
+	    (desc->end_fid & ~FUNCID_NUM_MASK))
+		return -EINVAL;
+
+	if (desc->start_fid > desc->end_fid)
+		return -EINVAL;
+
+	if ((desc->end_fid & FUNCID_NUM_MASK) >= RT_SVC_FID_NUM_ENTRIES)
+		return -EINVAL;
+
+	return 0;
+}
+
+/*******************************************************************************
+ * This function populates the dispatch tables with the function descriptors
+ * exported by the runtime services. A dispatch table is assigned to each
+ * unique oen that has at least one function descriptor, as long as the
+ * runtime service owning that oen has been initialised successfully. When no
+ * dispatch table is left, the SMCs are handled by the service descriptor.
+ ******************************************************************************/
+static void runtime_svc_fid_init(void)
+{
+	int rc;
+	unsigned int index, idx, entry, end_entry, table, num_tables = 0U;
+	rt_svc_fid_desc_t *rt_svc_fid_descs;
+
+	/* Descriptor indices must fit in 7 bits, bit 7 flags an invalid entry */
+	assert((RT_SVC_FID_DESCS_END >= RT_SVC_FID_DESCS_START) &&
+			(RT_SVC_FID_DECS_NUM < 128U));
+
+	rt_svc_fid_descs = (rt_svc_fid_desc_t *) RT_SVC_FID_DESCS_START;
+	for (index = 0; index < RT_SVC_FID_DECS_NUM; index++) {
+		rt_svc_fid_desc_t *desc = &rt_svc_fid_descs[index];
+
+		rc = validate_rt_svc_fid_desc(desc);
+		if (rc) {
+			ERROR("Invalid runtime service function descriptor %p\n",
+				(void *) desc);
+			panic();
+		}
+
+		/* Skip the functions of a service that failed to initialise */
+		idx = get_unique_oen_from_smc_fid(desc->start_fid);
+		if (rt_svc_descs_indices[idx] >= RT_SVC_DECS_NUM)
+			continue;
+
+		table = rt_svc_fid_tables_map[idx];
+		if (table >= RT_SVC_FID_TABLES) {
+			if (num_tables == RT_SVC_FID_TABLES) {
+				WARN("No SMC dispatch table left for 0x%x\n",
+					desc->start_fid);
+				continue;
+			}
+
+			table = num_tables++;
+			rt_svc_fid_tables_map[idx] = table;
+		}
+
+		entry = get_fid_table_entry(desc->start_fid);
+		end_entry = get_fid_table_entry(desc->end_fid);
+		for (; entry <= end_entry; entry++) {
+			/* Overlapping function descriptors are not allowed */
+			if (rt_svc_fid_indices[table][entry] < RT_SVC_FID_DECS_NUM) {
+				ERROR("Overlapping runtime service function descriptor %p\n",
+					(void *) desc);
+				panic();
+			}
+
+			rt_svc_fid_indices[table][entry] = index;
+		}
+	}
+}
+#endif /* SMCCC_MAJOR_VERSION */
+
 /*******************************************************************************
  * This function calls the initialisation routine in the descriptor exported by
  * a runtime service. Once a descriptor has been validated, its start & end
@@ -103,6 +347,12 @@ void runtime_svc_init(void)
 	assert((RT_SVC_DESCS_END >= RT_SVC_DESCS_START) &&
 			(RT_SVC_DECS_NUM < MAX_RT_SVCS));
 
+#if SMCCC_MAJOR_VERSION == 1
+	/* Fall back to the service descriptors until the tables are filled */
+	memset(rt_svc_fid_tables_map, -1, sizeof(rt_svc_fid_tables_map));
+	memset(rt_svc_fid_indices, -1, sizeof(rt_svc_fid_indices));
+#endif
+
 	/* If no runtime services are implemented then simply bail out */
 	if (RT_SVC_DECS_NUM == 0U)
 		return;
@@ -164,4 +414,8 @@ void runtime_svc_init(void)
 		for (; start_idx <= end_idx; start_idx++)
 			rt_svc_descs_indices[start_idx] = index;
 	}
+
+#if SMCCC_MAJOR_VERSION == 1
+	runtime_svc_fid_init();
+#endif
 }
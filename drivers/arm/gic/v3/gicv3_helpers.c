@@ -360,8 +360,10 @@ void gicv3_spis_config_defaults(uintptr_t gicd_base)
 	 * Treat all SPIs as G1NS by default. The number of interrupts is
 	 * calculated as 32 * (IT_LINES + 1). We do 32 at a time.
 	 */
-	for (index = MIN_SPI_ID; index < num_ints; index += 32U)
+	for (index = MIN_SPI_ID; index < num_ints; index += 32U) {
 		gicd_write_igroupr(gicd_base, index, ~0U);
+		gicv3_secure_spi_config_changed(index);
+	}
 
 	/* Setup the default SPI priorities doing four at a time */
 	for (index = MIN_SPI_ID; index < num_ints; index += 4U)
@@ -406,6 +408,7 @@ void gicv3_secure_spis_config(uintptr_t gicd_base,
 				gicd_set_igrpmodr(gicd_base, irq_num);
 			else
 				gicd_clr_igrpmodr(gicd_base, irq_num);
+			gicv3_secure_spi_config_changed(irq_num);
 
 			/* Set the priority of this interrupt */
 			gicd_set_ipriorityr(gicd_base,
@@ -427,58 +430,129 @@ void gicv3_secure_spis_config(uintptr_t gicd_base,
 }
 #endif
 
+#define INVALID_INTR_BLOCK	(~0U)
+
 /*******************************************************************************
- * Helper function to configure properties of secure SPIs
+ * Helper function to return the first INTID of the lowest block of 32 SPIs,
+ * starting from 'block_id', that has properties in the array. Returns
+ * INVALID_INTR_BLOCK if there is none.
+ ******************************************************************************/
+static unsigned int spi_props_next_block(const interrupt_prop_t *interrupt_props,
+					 unsigned int interrupt_props_num,
+					 unsigned int block_id)
+{
+	unsigned int i, id, next_block_id = INVALID_INTR_BLOCK;
+
+	for (i = 0U; i < interrupt_props_num; i++) {
+		id = interrupt_props[i].intr_num & ~((1U << IGROUPR_SHIFT) - 1U);
+		if ((id >= block_id) && (id < next_block_id))
+			next_block_id = id;
+	}
+
+	return next_block_id;
+}
+
+/*******************************************************************************
+ * Helper function to configure properties of secure SPIs. The properties are
+ * applied one block of 32 SPIs at a time: the final value of the GICD_IGROUPR,
+ * GICD_IGRPMODR, GICD_ICFGR and GICD_ISENABLER registers of a block is
+ * computed from all its properties before being written once. If an interrupt
+ * has several properties in the array, the last one applies.
  ******************************************************************************/
 unsigned int gicv3_secure_spis_config_props(uintptr_t gicd_base,
 		const interrupt_prop_t *interrupt_props,
 		unsigned int interrupt_props_num)
 {
-	unsigned int i;
+	unsigned int i, id, block_id, reg, shift;
 	const interrupt_prop_t *current_prop;
 	unsigned long long gic_affinity_val;
 	unsigned int ctlr_enable = 0U;
+	uint32_t bit, grp_clr, grpmod_set, grpmod_clr, enable;
+	uint32_t cfg_mask[2], cfg_val[2];
 
 	/* Make sure there's a valid property array */
 	if (interrupt_props_num > 0U)
 		assert(interrupt_props != NULL);
 
-	for (i = 0U; i < interrupt_props_num; i++) {
-		current_prop = &interrupt_props[i];
+	/* Target SPIs to the primary CPU */
+	gic_affinity_val = gicd_irouter_val_from_mpidr(read_mpidr(), 0U);
+
+	for (block_id = spi_props_next_block(interrupt_props,
+					     interrupt_props_num, MIN_SPI_ID);
+	     block_id != INVALID_INTR_BLOCK;
+	     block_id = spi_props_next_block(interrupt_props,
+					     interrupt_props_num,
+					     block_id + (1U << IGROUPR_SHIFT))) {
+		grp_clr = 0U;
+		grpmod_set = 0U;
+		grpmod_clr = 0U;
+		enable = 0U;
+		cfg_mask[0] = 0U;
+		cfg_mask[1] = 0U;
+		cfg_val[0] = 0U;
+		cfg_val[1] = 0U;
+
+		for (i = 0U; i < interrupt_props_num; i++) {
+			current_prop = &interrupt_props[i];
+			id = current_prop->intr_num;
+
+			if ((id & ~((1U << IGROUPR_SHIFT) - 1U)) != block_id)
+				continue;
+
+			bit = 1U << (id & ((1U << IGROUPR_SHIFT) - 1U));
 
-		if (current_prop->intr_num < MIN_SPI_ID)
-			continue;
+			/* Configure this interrupt as a secure interrupt */
+			grp_clr |= bit;
 
-		/* Configure this interrupt as a secure interrupt */
-		gicd_clr_igroupr(gicd_base, current_prop->intr_num);
+			/* Configure this interrupt as G0 or a G1S interrupt */
+			assert((current_prop->intr_grp == INTR_GROUP0) ||
+					(current_prop->intr_grp == INTR_GROUP1S));
+			if (current_prop->intr_grp == INTR_GROUP1S) {
+				grpmod_set |= bit;
+				grpmod_clr &= ~bit;
+				ctlr_enable |= CTLR_ENABLE_G1S_BIT;
+			} else {
+				grpmod_clr |= bit;
+				grpmod_set &= ~bit;
+				ctlr_enable |= CTLR_ENABLE_G0_BIT;
+			}
+
+			/* Set interrupt configuration, 16 interrupts per word */
+			reg = (id >> ICFGR_SHIFT) & 1U;
+			shift = (id & ((1U << ICFGR_SHIFT) - 1U)) << 1;
+			cfg_mask[reg] |= GIC_CFG_MASK << shift;
+			cfg_val[reg] &= ~(GIC_CFG_MASK << shift);
+			cfg_val[reg] |= (current_prop->intr_cfg & GIC_CFG_MASK)
+					<< shift;
 
-		/* Configure this interrupt as G0 or a G1S interrupt */
-		assert((current_prop->intr_grp == INTR_GROUP0) ||
-				(current_prop->intr_grp == INTR_GROUP1S));
-		if (current_prop->intr_grp == INTR_GROUP1S) {
-			gicd_set_igrpmodr(gicd_base, current_prop->intr_num);
-			ctlr_enable |= CTLR_ENABLE_G1S_BIT;
-		} else {
-			gicd_clr_igrpmodr(gicd_base, current_prop->intr_num);
-			ctlr_enable |= CTLR_ENABLE_G0_BIT;
-		}
+			/* Set the priority of this interrupt */
+			gicd_set_ipriorityr(gicd_base, id,
+					current_prop->intr_pri);
 
-		/* Set interrupt configuration */
-		gicd_set_icfgr(gicd_base, current_prop->intr_num,
-				current_prop->intr_cfg);
+			/* Target this interrupt to the primary CPU */
+			gicd_write_irouter(gicd_base, id, gic_affinity_val);
 
-		/* Set the priority of this interrupt */
-		gicd_set_ipriorityr(gicd_base, current_prop->intr_num,
-				current_prop->intr_pri);
+			enable |= bit;
+		}
 
-		/* Target SPIs to the primary CPU */
-		gic_affinity_val =
-			gicd_irouter_val_from_mpidr(read_mpidr(), 0U);
-		gicd_write_irouter(gicd_base, current_prop->intr_num,
-				gic_affinity_val);
+		gicd_write_igroupr(gicd_base, block_id,
+			gicd_read_igroupr(gicd_base, block_id) & ~grp_clr);
+		gicd_write_igrpmodr(gicd_base, block_id,
+			(gicd_read_igrpmodr(gicd_base, block_id) & ~grpmod_clr) |
+			grpmod_set);
+		gicv3_secure_spi_config_changed(block_id);
+
+		for (reg = 0U; reg < 2U; reg++) {
+			id = block_id + (reg << ICFGR_SHIFT);
+			if (cfg_mask[reg] != 0U) {
+				gicd_write_icfgr(gicd_base, id,
+					(gicd_read_icfgr(gicd_base, id) &
+					 ~cfg_mask[reg]) | cfg_val[reg]);
+			}
+		}
 
-		/* Enable this interrupt */
-		gicd_set_isenabler(gicd_base, current_prop->intr_num);
+		/* Enable the interrupts of this block once configured */
+		gicd_write_isenabler(gicd_base, block_id, enable);
 	}
 
 	return ctlr_enable;
@@ -501,6 +575,7 @@ void gicv3_ppi_sgi_config_defaults(uintptr_t gicr_base)
 
 	/* Treat all SGIs/PPIs as G1NS by default. */
 	gicr_write_igroupr0(gicr_base, ~0U);
+	gicv3_secure_ppi_sgi_config_changed();
 
 	/* Setup the default PPI/SGI priorities doing four at a time */
 	for (index = 0U; index < MIN_SPI_ID; index += 4U)
@@ -540,6 +615,7 @@ void gicv3_secure_ppi_sgi_config(uintptr_t gicr_base,
 				gicr_set_igrpmodr0(gicr_base, irq_num);
 			else
 				gicr_clr_igrpmodr0(gicr_base, irq_num);
+			gicv3_secure_ppi_sgi_config_changed();
 
 			/* Set the priority of this interrupt */
 			gicr_set_ipriorityr(gicr_base,
@@ -555,14 +631,20 @@ void gicv3_secure_ppi_sgi_config(uintptr_t gicr_base,
 
 /*******************************************************************************
  * Helper function to configure properties of secure G0 and G1S PPIs and SGIs.
+ * The final value of GICR_IGROUPR0, GICR_IGRPMODR0, GICR_ICFGR1 and
+ * GICR_ISENABLER0 is computed from all the properties before being written
+ * once. If an interrupt has several properties in the array, the last one
+ * applies.
  ******************************************************************************/
 unsigned int gicv3_secure_ppi_sgi_config_props(uintptr_t gicr_base,
 		const interrupt_prop_t *interrupt_props,
 		unsigned int interrupt_props_num)
 {
-	unsigned int i;
+	unsigned int i, id, shift;
 	const interrupt_prop_t *current_prop;
 	unsigned int ctlr_enable = 0U;
+	uint32_t bit, grp_clr = 0U, grpmod_set = 0U, grpmod_clr = 0U;
+	uint32_t enable = 0U, cfg_mask = 0U, cfg_val = 0U;
 
 	/* Make sure there's a valid property array */
 	if (interrupt_props_num > 0U)
@@ -570,41 +652,60 @@ unsigned int gicv3_secure_ppi_sgi_config_props(uintptr_t gicr_base,
 
 	for (i = 0U; i < interrupt_props_num; i++) {
 		current_prop = &interrupt_props[i];
+		id = current_prop->intr_num;
 
-		if (current_prop->intr_num >= MIN_SPI_ID)
+		if (id >= MIN_SPI_ID)
 			continue;
 
+		bit = 1U << id;
+
 		/* Configure this interrupt as a secure interrupt */
-		gicr_clr_igroupr0(gicr_base, current_prop->intr_num);
+		grp_clr |= bit;
 
 		/* Configure this interrupt as G0 or a G1S interrupt */
 		assert((current_prop->intr_grp == INTR_GROUP0) ||
 				(current_prop->intr_grp == INTR_GROUP1S));
 		if (current_prop->intr_grp == INTR_GROUP1S) {
-			gicr_set_igrpmodr0(gicr_base, current_prop->intr_num);
+			grpmod_set |= bit;
+			grpmod_clr &= ~bit;
 			ctlr_enable |= CTLR_ENABLE_G1S_BIT;
 		} else {
-			gicr_clr_igrpmodr0(gicr_base, current_prop->intr_num);
+			grpmod_clr |= bit;
+			grpmod_set &= ~bit;
 			ctlr_enable |= CTLR_ENABLE_G0_BIT;
 		}
 
 		/* Set the priority of this interrupt */
-		gicr_set_ipriorityr(gicr_base, current_prop->intr_num,
-				current_prop->intr_pri);
+		gicr_set_ipriorityr(gicr_base, id, current_prop->intr_pri);
 
 		/*
 		 * Set interrupt configuration for PPIs. Configuration for SGIs
 		 * are ignored.
 		 */
-		if ((current_prop->intr_num >= MIN_PPI_ID) &&
-				(current_prop->intr_num < MIN_SPI_ID)) {
-			gicr_set_icfgr1(gicr_base, current_prop->intr_num,
-					current_prop->intr_cfg);
+		if (id >= MIN_PPI_ID) {
+			shift = (id - MIN_PPI_ID) << 1;
+			cfg_mask |= GIC_CFG_MASK << shift;
+			cfg_val &= ~(GIC_CFG_MASK << shift);
+			cfg_val |= (current_prop->intr_cfg & GIC_CFG_MASK) << shift;
 		}
 
-		/* Enable this interrupt */
-		gicr_set_isenabler0(gicr_base, current_prop->intr_num);
+		enable |= bit;
 	}
 
+	if (enable == 0U)
+		return ctlr_enable;
+
+	gicr_write_igroupr0(gicr_base, gicr_read_igroupr0(gicr_base) & ~grp_clr);
+	gicr_write_igrpmodr0(gicr_base,
+		(gicr_read_igrpmodr0(gicr_base) & ~grpmod_clr) | grpmod_set);
+	gicv3_secure_ppi_sgi_config_changed();
+	if (cfg_mask != 0U) {
+		gicr_write_icfgr1(gicr_base,
+			(gicr_read_icfgr1(gicr_base) & ~cfg_mask) | cfg_val);
+	}
+
+	/* Enable the interrupts once configured */
+	gicr_write_isenabler0(gicr_base, enable);
+
 	return ctlr_enable;
 }
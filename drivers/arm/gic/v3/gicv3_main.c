@@ -41,6 +41,21 @@ static spinlock_t gic_lock;
 		}							\
 	} while (false)
 
+/*
+ * Writing zero to a GICD_IS* register has no effect, so the registers whose
+ * saved value is zero are skipped.
+ */
+#define RESTORE_GICD_SET_REGS(base, ctx, intr_num, reg, REG)		\
+	do {								\
+		for (unsigned int int_id = MIN_SPI_ID; int_id < (intr_num); \
+				int_id += (1U << REG##_SHIFT)) {	\
+			uint32_t val = ctx->gicd_##reg[			\
+				(int_id - MIN_SPI_ID) >> REG##_SHIFT];	\
+			if (val != 0U)					\
+				gicd_write_##reg(base, int_id, val);	\
+		}							\
+	} while (false)
+
 #define SAVE_GICD_REGS(base, ctx, intr_num, reg, REG)			\
 	do {								\
 		for (unsigned int int_id = MIN_SPI_ID; int_id < (intr_num); \
@@ -577,6 +592,47 @@ void gicv3_its_restore(uintptr_t gits_base, const gicv3_its_ctx_t * const its_ct
 			(~GITS_CTLR_ENABLED_BIT));
 }
 
+#if GICV3_TRACK_SECURE_CONFIG
+/*
+ * Generation of the last change to the Secure-only configuration of the SGIs
+ * and PPIs of any Redistributor, as recorded by
+ * gicv3_secure_ppi_sgi_config_changed(). The Redistributors are configured by
+ * their CPUs concurrently, so the generation is updated under the lock.
+ */
+static unsigned int gicv3_secure_ppi_sgi_config_gen = 1U;
+
+void gicv3_secure_ppi_sgi_config_changed(void)
+{
+	spin_lock(&gic_lock);
+	gicv3_secure_ppi_sgi_config_gen++;
+	spin_unlock(&gic_lock);
+}
+
+/*
+ * GICR_IGROUPR0, GICR_IGRPMODR0 and GICR_NSACR are RAZ/WI to Non-secure
+ * accesses, so they can only change through the driver. Only read them back
+ * if the Secure configuration of the SGIs and PPIs changed since the context
+ * was last saved from the same Redistributor.
+ */
+static void gicv3_rdistif_save_secure_config(unsigned int proc_num,
+					uintptr_t gicr_base,
+					gicv3_redist_ctx_t * const rdist_ctx)
+{
+	unsigned int gen = gicv3_secure_ppi_sgi_config_gen;
+
+	if ((rdist_ctx->gicr_secure_config_gen == gen) &&
+	    (rdist_ctx->gicr_secure_config_proc == proc_num))
+		return;
+
+	rdist_ctx->gicr_igroupr0 = gicr_read_igroupr0(gicr_base);
+	rdist_ctx->gicr_igrpmodr0 = gicr_read_igrpmodr0(gicr_base);
+	rdist_ctx->gicr_nsacr = gicr_read_nsacr(gicr_base);
+
+	rdist_ctx->gicr_secure_config_gen = gen;
+	rdist_ctx->gicr_secure_config_proc = proc_num;
+}
+#endif /* GICV3_TRACK_SECURE_CONFIG */
+
 /*****************************************************************************
  * Function to save the GIC Redistributor register context. This function
  * must be invoked after CPU interface disable and prior to Distributor save.
@@ -605,14 +661,21 @@ void gicv3_rdistif_save(unsigned int proc_num, gicv3_redist_ctx_t * const rdist_
 	rdist_ctx->gicr_propbaser = gicr_read_propbaser(gicr_base);
 	rdist_ctx->gicr_pendbaser = gicr_read_pendbaser(gicr_base);
 
+#if GICV3_TRACK_SECURE_CONFIG
+	/* Save the Secure-only GICR registers if changed since the last save */
+	gicv3_rdistif_save_secure_config(proc_num, gicr_base, rdist_ctx);
+#else
 	rdist_ctx->gicr_igroupr0 = gicr_read_igroupr0(gicr_base);
+#endif
 	rdist_ctx->gicr_isenabler0 = gicr_read_isenabler0(gicr_base);
 	rdist_ctx->gicr_ispendr0 = gicr_read_ispendr0(gicr_base);
 	rdist_ctx->gicr_isactiver0 = gicr_read_isactiver0(gicr_base);
 	rdist_ctx->gicr_icfgr0 = gicr_read_icfgr0(gicr_base);
 	rdist_ctx->gicr_icfgr1 = gicr_read_icfgr1(gicr_base);
+#if !GICV3_TRACK_SECURE_CONFIG
 	rdist_ctx->gicr_igrpmodr0 = gicr_read_igrpmodr0(gicr_base);
 	rdist_ctx->gicr_nsacr = gicr_read_nsacr(gicr_base);
+#endif
 	for (int_id = MIN_SGI_ID; int_id < TOTAL_PCPU_INTR_NUM;
 			int_id += (1U << IPRIORITYR_SHIFT)) {
 		rdist_ctx->gicr_ipriorityr[(int_id - MIN_SGI_ID) >> IPRIORITYR_SHIFT] =
@@ -693,16 +756,22 @@ void gicv3_rdistif_init_restore(unsigned int proc_num,
 	gicr_write_igrpmodr0(gicr_base, rdist_ctx->gicr_igrpmodr0);
 	gicr_write_nsacr(gicr_base, rdist_ctx->gicr_nsacr);
 
-	/* Restore after group and priorities are set */
-	gicr_write_ispendr0(gicr_base, rdist_ctx->gicr_ispendr0);
-	gicr_write_isactiver0(gicr_base, rdist_ctx->gicr_isactiver0);
+	/*
+	 * Restore after group and priorities are set. Writing zero to a
+	 * GICR_IS* register has no effect, so it is skipped.
+	 */
+	if (rdist_ctx->gicr_ispendr0 != 0U)
+		gicr_write_ispendr0(gicr_base, rdist_ctx->gicr_ispendr0);
+	if (rdist_ctx->gicr_isactiver0 != 0U)
+		gicr_write_isactiver0(gicr_base, rdist_ctx->gicr_isactiver0);
 
 	/*
 	 * Wait for all writes to the Distributor to complete before enabling
 	 * the SGI and PPIs.
 	 */
 	gicr_wait_for_upstream_pending_write(gicr_base);
-	gicr_write_isenabler0(gicr_base, rdist_ctx->gicr_isenabler0);
+	if (rdist_ctx->gicr_isenabler0 != 0U)
+		gicr_write_isenabler0(gicr_base, rdist_ctx->gicr_isenabler0);
 
 	/*
 	 * Restore GICR_CTLR.Enable_LPIs bit and wait for pending writes in case
@@ -714,6 +783,66 @@ void gicv3_rdistif_init_restore(unsigned int proc_num,
 	gicr_wait_for_pending_write(gicr_base);
 }
 
+#if GICV3_TRACK_SECURE_CONFIG
+/*
+ * Generation of the last change to the Secure-only configuration of each
+ * block of 32 SPIs, as recorded by gicv3_secure_spi_config_changed(). A
+ * distributor context records the generation it was saved at, 0 meaning that
+ * it was never saved.
+ */
+static unsigned int gicv3_secure_config_gen = 1U;
+static unsigned int gicv3_secure_config_block_gen[GICD_NUM_REGS(IGROUPR)];
+
+void gicv3_secure_spi_config_changed(unsigned int id)
+{
+	if (id < MIN_SPI_ID)
+		return;
+
+	assert(((id - MIN_SPI_ID) >> IGROUPR_SHIFT) <
+	       GICD_NUM_REGS(IGROUPR));
+
+	gicv3_secure_config_gen++;
+	gicv3_secure_config_block_gen[(id - MIN_SPI_ID) >> IGROUPR_SHIFT] =
+		gicv3_secure_config_gen;
+}
+
+/*
+ * GICD_IGROUPR, GICD_IGRPMODR and GICD_NSACR are RAZ/WI to Non-secure
+ * accesses, so they can only change through the driver. Only read back the
+ * blocks of SPIs whose configuration changed since the context was last
+ * saved.
+ */
+static void gicv3_distif_save_secure_config(uintptr_t gicd_base,
+					    gicv3_dist_ctx_t * const dist_ctx,
+					    unsigned int num_ints)
+{
+	unsigned int int_id, block, nsacr_id;
+
+	for (int_id = MIN_SPI_ID; int_id < num_ints;
+			int_id += (1U << IGROUPR_SHIFT)) {
+		block = (int_id - MIN_SPI_ID) >> IGROUPR_SHIFT;
+		if ((dist_ctx->gicd_secure_config_gen != 0U) &&
+		    (gicv3_secure_config_block_gen[block] <=
+		     dist_ctx->gicd_secure_config_gen))
+			continue;
+
+		dist_ctx->gicd_igroupr[block] =
+			gicd_read_igroupr(gicd_base, int_id);
+		dist_ctx->gicd_igrpmodr[block] =
+			gicd_read_igrpmodr(gicd_base, int_id);
+		for (nsacr_id = int_id;
+		     nsacr_id < (int_id + (1U << IGROUPR_SHIFT));
+		     nsacr_id += (1U << NSACR_SHIFT)) {
+			dist_ctx->gicd_nsacr[(nsacr_id - MIN_SPI_ID) >>
+					     NSACR_SHIFT] =
+				gicd_read_nsacr(gicd_base, nsacr_id);
+		}
+	}
+
+	dist_ctx->gicd_secure_config_gen = gicv3_secure_config_gen;
+}
+#endif /* GICV3_TRACK_SECURE_CONFIG */
+
 /*****************************************************************************
  * Function to save the GIC Distributor register context. This function
  * must be invoked after CPU interface disable and Redistributor save.
@@ -741,8 +870,13 @@ void gicv3_distif_save(gicv3_dist_ctx_t * const dist_ctx)
 	/* Save the GICD_CTLR */
 	dist_ctx->gicd_ctlr = gicd_read_ctlr(gicd_base);
 
+#if GICV3_TRACK_SECURE_CONFIG
+	/* Save the Secure-only GICD registers changed since the last save */
+	gicv3_distif_save_secure_config(gicd_base, dist_ctx, num_ints);
+#else
 	/* Save GICD_IGROUPR for INTIDs 32 - 1020 */
 	SAVE_GICD_REGS(gicd_base, dist_ctx, num_ints, igroupr, IGROUPR);
+#endif
 
 	/* Save GICD_ISENABLER for INT_IDs 32 - 1020 */
 	SAVE_GICD_REGS(gicd_base, dist_ctx, num_ints, isenabler, ISENABLER);
@@ -759,11 +893,13 @@ void gicv3_distif_save(gicv3_dist_ctx_t * const dist_ctx)
 	/* Save GICD_ICFGR for INTIDs 32 - 1020 */
 	SAVE_GICD_REGS(gicd_base, dist_ctx, num_ints, icfgr, ICFGR);
 
+#if !GICV3_TRACK_SECURE_CONFIG
 	/* Save GICD_IGRPMODR for INTIDs 32 - 1020 */
 	SAVE_GICD_REGS(gicd_base, dist_ctx, num_ints, igrpmodr, IGRPMODR);
 
 	/* Save GICD_NSACR for INTIDs 32 - 1020 */
 	SAVE_GICD_REGS(gicd_base, dist_ctx, num_ints, nsacr, NSACR);
+#endif
 
 	/* Save GICD_IROUTER for INTIDs 32 - 1024 */
 	SAVE_GICD_REGS(gicd_base, dist_ctx, num_ints, irouter, IROUTER);
@@ -837,13 +973,13 @@ void gicv3_distif_init_restore(const gicv3_dist_ctx_t * const dist_ctx)
 	 */
 
 	/* Restore GICD_ISENABLER for INT_IDs 32 - 1020 */
-	RESTORE_GICD_REGS(gicd_base, dist_ctx, num_ints, isenabler, ISENABLER);
+	RESTORE_GICD_SET_REGS(gicd_base, dist_ctx, num_ints, isenabler, ISENABLER);
 
 	/* Restore GICD_ISPENDR for INTIDs 32 - 1020 */
-	RESTORE_GICD_REGS(gicd_base, dist_ctx, num_ints, ispendr, ISPENDR);
+	RESTORE_GICD_SET_REGS(gicd_base, dist_ctx, num_ints, ispendr, ISPENDR);
 
 	/* Restore GICD_ISACTIVER for INTIDs 32 - 1020 */
-	RESTORE_GICD_REGS(gicd_base, dist_ctx, num_ints, isactiver, ISACTIVER);
+	RESTORE_GICD_SET_REGS(gicd_base, dist_ctx, num_ints, isactiver, ISACTIVER);
 
 	/* Restore the GICD_CTLR */
 	gicd_write_ctlr(gicd_base, dist_ctx->gicd_ctlr);
@@ -1019,6 +1155,7 @@ void gicv3_set_interrupt_type(unsigned int id, unsigned int proc_num,
 			gicr_set_igrpmodr0(gicr_base, id);
 		else
 			gicr_clr_igrpmodr0(gicr_base, id);
+		gicv3_secure_ppi_sgi_config_changed();
 	} else {
 		/* Serialize read-modify-write to Distributor registers */
 		spin_lock(&gic_lock);
@@ -1031,6 +1168,7 @@ void gicv3_set_interrupt_type(unsigned int id, unsigned int proc_num,
 			gicd_set_igrpmodr(gicv3_driver_data->gicd_base, id);
 		else
 			gicd_clr_igrpmodr(gicv3_driver_data->gicd_base, id);
+		gicv3_secure_spi_config_changed(id);
 		spin_unlock(&gic_lock);
 	}
 }
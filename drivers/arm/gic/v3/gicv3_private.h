@@ -118,6 +118,26 @@ void gicv3_rdistif_base_addrs_probe(uintptr_t *rdistif_base_addrs,
 void gicv3_rdistif_mark_core_awake(uintptr_t gicr_base);
 void gicv3_rdistif_mark_core_asleep(uintptr_t gicr_base);
 
+/*
+ * Record that the driver changed the Secure-only configuration of an SPI, or of
+ * the SGIs and PPIs of a Redistributor. Every change made to GICD_IGROUPR,
+ * GICD_IGRPMODR, GICD_NSACR, GICR_IGROUPR0, GICR_IGRPMODR0 or GICR_NSACR
+ * outside of a context restore must be recorded for gicv3_distif_save() and
+ * gicv3_rdistif_save() to pick it up.
+ */
+#if GICV3_TRACK_SECURE_CONFIG
+void gicv3_secure_spi_config_changed(unsigned int id);
+void gicv3_secure_ppi_sgi_config_changed(void);
+#else
+static inline void gicv3_secure_spi_config_changed(unsigned int id)
+{
+}
+
+static inline void gicv3_secure_ppi_sgi_config_changed(void)
+{
+}
+#endif
+
 /*******************************************************************************
  * GIC Distributor interface accessors
  ******************************************************************************/
@@ -4,9 +4,11 @@
  * SPDX-License-Identifier: BSD-3-Clause
  */
 
+#include <arch_helpers.h>
 #include <assert.h>
 #include <auth_common.h>
 #include <auth_mod.h>
+#include <cassert.h>
 #include <cot_def.h>
 #include <crypto_mod.h>
 #include <debug.h>
@@ -32,6 +34,65 @@
 extern const auth_img_desc_t *const cot_desc_ptr;
 extern unsigned int auth_img_flags[MAX_NUMBER_IDS];
 
+#if STREAM_IMAGE_HASH
+/*
+ * State of the hash calculated while an image is being loaded. Once the stream
+ * is finished, 'verified' tells auth_hash() that the data at 'img_ptr' of size
+ * 'img_len' matches the hash of the parent image, so it is not hashed again.
+ * 'active' is set between the start and the end of the stream.
+ */
+static struct {
+	unsigned int img_id;
+	void *img_ptr;
+	unsigned int img_len;
+	int error;
+	int verified;
+	int active;
+} hash_stream;
+#endif
+
+#if AUTH_CERT_CACHE
+/*
+ * Certificates verified by BL1, handed over to BL2 in the memory region defined
+ * by PLAT_AUTH_CERT_CACHE_BASE and PLAT_AUTH_CERT_CACHE_SIZE. Each record holds
+ * the hash of a certificate, its NV counter and the parameters extracted from
+ * it. When BL2 authenticates a certificate whose hash matches the record of the
+ * same image, the parameters are taken from the record instead of verifying
+ * the signature and parsing the certificate again. Only BL1 writes the region.
+ */
+#define AUTH_CERT_CACHE_MAGIC		0x41434331U	/* "ACC1" */
+#define AUTH_CERT_CACHE_HASH_LEN	64U
+
+#define cert_cache_align(len)		(((len) + 3U) & ~3U)
+
+typedef struct auth_cert_cache_hdr_s {
+	unsigned int magic;
+	unsigned int used;		/* Size of the records that follow */
+} auth_cert_cache_hdr_t;
+
+typedef struct auth_cert_cache_rec_s {
+	unsigned int img_id;
+	unsigned int size;		/* Size of the record and parameters */
+	unsigned int nv_ctr;
+	unsigned int hash_len;
+	unsigned char hash[AUTH_CERT_CACHE_HASH_LEN];
+	/*
+	 * Followed, for each entry of 'authenticated_data' in the image
+	 * descriptor, by the length of the parameter and the parameter itself,
+	 * padded to a multiple of 4 bytes.
+	 */
+} auth_cert_cache_rec_t;
+
+CASSERT(PLAT_AUTH_CERT_CACHE_SIZE > sizeof(auth_cert_cache_hdr_t),
+	assert_auth_cert_cache_size);
+CASSERT((PLAT_AUTH_CERT_CACHE_BASE & 3U) == 0U,
+	assert_auth_cert_cache_base_aligned);
+
+static auth_cert_cache_hdr_t *const cert_cache =
+	(auth_cert_cache_hdr_t *)PLAT_AUTH_CERT_CACHE_BASE;
+static int cert_cache_valid;
+#endif
+
 static int cmp_auth_param_type_desc(const auth_param_type_desc_t *a,
 		const auth_param_type_desc_t *b)
 {
@@ -107,6 +168,18 @@ static int auth_hash(const auth_method_param_hash_t *param,
 			img, img_len, &data_ptr, &data_len);
 	return_if_error(rc);
 
+#if STREAM_IMAGE_HASH
+	/* Check whether the hash has been verified while loading the image */
+	if (hash_stream.verified != 0) {
+		hash_stream.verified = 0;
+		if ((hash_stream.img_id == img_desc->img_id) &&
+		    (hash_stream.img_ptr == data_ptr) &&
+		    (hash_stream.img_len == data_len)) {
+			return 0;
+		}
+	}
+#endif
+
 	/* Ask the crypto module to verify this hash */
 	rc = crypto_mod_verify_hash(data_ptr, data_len,
 				    hash_der_ptr, hash_der_len);
@@ -224,14 +297,38 @@ static int auth_signature(const auth_method_param_sig_t *param,
  *
  * Return: 0 = success, Otherwise = error
  */
+static int auth_nvctr_check(const auth_method_param_nv_ctr_t *param,
+			    const auth_img_desc_t *img_desc,
+			    unsigned int cert_nv_ctr)
+{
+	unsigned int plat_nv_ctr;
+	int rc;
+
+	/* Get the counter from the platform */
+	rc = plat_get_nv_ctr(param->plat_nv_ctr->cookie, &plat_nv_ctr);
+	return_if_error(rc);
+
+	if (cert_nv_ctr < plat_nv_ctr) {
+		/* Invalid NV-counter */
+		return 1;
+	} else if (cert_nv_ctr > plat_nv_ctr) {
+		rc = plat_set_nv_ctr2(param->plat_nv_ctr->cookie,
+			img_desc, cert_nv_ctr);
+		return_if_error(rc);
+	}
+
+	return 0;
+}
+
 static int auth_nvctr(const auth_method_param_nv_ctr_t *param,
 		      const auth_img_desc_t *img_desc,
-		      void *img, unsigned int img_len)
+		      void *img, unsigned int img_len,
+		      unsigned int *nv_ctr)
 {
 	char *p;
 	void *data_ptr = NULL;
 	unsigned int data_len, len, i;
-	unsigned int cert_nv_ctr, plat_nv_ctr;
+	unsigned int cert_nv_ctr;
 	int rc = 0;
 
 	/* Get the counter value from current image. The AM expects the IPM
@@ -266,28 +363,306 @@ static int auth_nvctr(const auth_method_param_nv_ctr_t *param,
 	for (i = 0; i < len; i++) {
 		cert_nv_ctr = (cert_nv_ctr << 8) | *p++;
 	}
+	*nv_ctr = cert_nv_ctr;
 
-	/* Get the counter from the platform */
-	rc = plat_get_nv_ctr(param->plat_nv_ctr->cookie, &plat_nv_ctr);
-	return_if_error(rc);
+	return auth_nvctr_check(param, img_desc, cert_nv_ctr);
+}
 
-	if (cert_nv_ctr < plat_nv_ctr) {
-		/* Invalid NV-counter */
+int plat_set_nv_ctr2(void *cookie, const auth_img_desc_t *img_desc __unused,
+		unsigned int nv_ctr)
+{
+	return plat_set_nv_ctr(cookie, nv_ctr);
+}
+
+#if STREAM_IMAGE_HASH
+/*
+ * Start calculating the hash of an image while it is being loaded at
+ * 'img_ptr'. This is only possible for raw images authenticated by their hash,
+ * once the parent image has been authenticated. The data is then passed in the
+ * order it is loaded to auth_mod_hash_stream_update(), and
+ * auth_mod_hash_stream_finish() must be called with the size of the data
+ * loaded before the image is authenticated with auth_mod_verify_img().
+ *
+ * Return: 0 = stream started, Otherwise = the image must be hashed by
+ * auth_mod_verify_img() as usual
+ */
+int auth_mod_hash_stream_start(unsigned int img_id, void *img_ptr)
+{
+	const auth_img_desc_t *img_desc = NULL;
+	const auth_method_desc_t *auth_method = NULL;
+	void *hash_der_ptr;
+	unsigned int hash_der_len;
+	int rc, i;
+
+	/* Only one image can be hashed at a time */
+	if (hash_stream.active != 0) {
 		return 1;
-	} else if (cert_nv_ctr > plat_nv_ctr) {
-		rc = plat_set_nv_ctr2(param->plat_nv_ctr->cookie,
-			img_desc, cert_nv_ctr);
+	}
+
+	hash_stream.verified = 0;
+
+	/* Get the image descriptor from the chain of trust */
+	img_desc = &cot_desc_ptr[img_id];
+
+	/* Only the hash of a raw image covers the data as it is loaded */
+	if ((img_desc->img_type != IMG_RAW) || (img_desc->parent == NULL)) {
+		return 1;
+	}
+
+	for (i = 0 ; i < AUTH_METHOD_NUM ; i++) {
+		auth_method = &img_desc->img_auth_methods[i];
+		if (auth_method->type != AUTH_METHOD_HASH) {
+			continue;
+		}
+
+		/* Get the hash from the parent image */
+		rc = auth_get_param(auth_method->param.hash.hash,
+				img_desc->parent, &hash_der_ptr, &hash_der_len);
+		return_if_error(rc);
+
+		rc = crypto_mod_hash_stream_start(hash_der_ptr, hash_der_len);
 		return_if_error(rc);
+
+		hash_stream.img_id = img_id;
+		hash_stream.img_ptr = img_ptr;
+		hash_stream.error = 0;
+		hash_stream.active = 1;
+		return 0;
 	}
 
-	return 0;
+	return 1;
 }
 
-int plat_set_nv_ctr2(void *cookie, const auth_img_desc_t *img_desc __unused,
-		unsigned int nv_ctr)
+/*
+ * Add the next chunk of loaded data to the hash of the image. Errors are
+ * reported by auth_mod_verify_img(), which then hashes the image again.
+ */
+void auth_mod_hash_stream_update(void *data_ptr, unsigned int data_len)
 {
-	return plat_set_nv_ctr(cookie, nv_ctr);
+	if (hash_stream.error == 0) {
+		hash_stream.error = crypto_mod_hash_stream_update(data_ptr,
+								  data_len);
+	}
+}
+
+/*
+ * Finish calculating the hash of an image of 'img_len' bytes.
+ */
+void auth_mod_hash_stream_finish(unsigned int img_len)
+{
+	int rc = crypto_mod_hash_stream_finish();
+
+	hash_stream.active = 0;
+	if ((rc == 0) && (hash_stream.error == 0)) {
+		hash_stream.img_len = img_len;
+		hash_stream.verified = 1;
+	}
 }
+#endif /* STREAM_IMAGE_HASH */
+
+#if AUTH_CERT_CACHE
+/*
+ * Return the record of image 'img_id' in the certificate cache, or NULL. BL2
+ * cannot trust the content of the region, so the walk stops at the first
+ * record that does not fit entirely in the used part of the region. A record
+ * returned by this function is at least as large as its header.
+ */
+static auth_cert_cache_rec_t *auth_cert_cache_find(unsigned int img_id)
+{
+	uintptr_t base = (uintptr_t)(cert_cache + 1);
+	size_t used = cert_cache->used;
+	size_t offset = 0U, size;
+	auth_cert_cache_rec_t *r;
+
+	if (used > (PLAT_AUTH_CERT_CACHE_SIZE - sizeof(*cert_cache))) {
+		return NULL;
+	}
+
+	while ((used - offset) >= sizeof(*r)) {
+		r = (auth_cert_cache_rec_t *)(base + offset);
+		size = r->size;
+		if ((size < sizeof(*r)) || (size > (used - offset)) ||
+		    ((size & 3U) != 0U)) {
+			break;
+		}
+		if (r->img_id == img_id) {
+			return r;
+		}
+		offset += size;
+	}
+
+	return NULL;
+}
+
+#ifdef IMAGE_BL1
+/*
+ * Reset the certificate cache. Any data left in the region by a previous boot
+ * is discarded.
+ */
+static void auth_cert_cache_init(void)
+{
+	cert_cache->magic = AUTH_CERT_CACHE_MAGIC;
+	cert_cache->used = 0U;
+	flush_dcache_range((uintptr_t)cert_cache, sizeof(*cert_cache));
+	cert_cache_valid = 1;
+}
+
+/*
+ * Record a certificate that has just been authenticated, with its NV counter
+ * and the length of the parameters extracted from it. The certificate is not
+ * recorded if it does not fit in the cache.
+ */
+static void auth_cert_cache_add(const auth_img_desc_t *img_desc,
+				void *img_ptr, unsigned int img_len,
+				unsigned int nv_ctr,
+				const unsigned int *param_len)
+{
+	auth_cert_cache_rec_t *rec;
+	unsigned char *p;
+	unsigned int size = sizeof(*rec);
+	unsigned int hash_len = AUTH_CERT_CACHE_HASH_LEN;
+	int i;
+
+	if ((cert_cache_valid == 0) ||
+	    (auth_cert_cache_find(img_desc->img_id) != NULL)) {
+		return;
+	}
+
+	for (i = 0 ; i < COT_MAX_VERIFIED_PARAMS ; i++) {
+		if (img_desc->authenticated_data[i].type_desc != NULL) {
+			size += sizeof(unsigned int) +
+				cert_cache_align(param_len[i]);
+		}
+	}
+
+	if (size > (PLAT_AUTH_CERT_CACHE_SIZE - sizeof(*cert_cache) -
+		    cert_cache->used)) {
+		VERBOSE("No room to record certificate %u\n",
+			img_desc->img_id);
+		return;
+	}
+
+	rec = (auth_cert_cache_rec_t *)((uintptr_t)(cert_cache + 1) +
+					cert_cache->used);
+	if (crypto_mod_calc_hash(img_ptr, img_len, rec->hash, &hash_len) != 0) {
+		return;
+	}
+	rec->img_id = img_desc->img_id;
+	rec->size = size;
+	rec->nv_ctr = nv_ctr;
+	rec->hash_len = hash_len;
+
+	p = (unsigned char *)(rec + 1);
+	for (i = 0 ; i < COT_MAX_VERIFIED_PARAMS ; i++) {
+		if (img_desc->authenticated_data[i].type_desc == NULL) {
+			continue;
+		}
+		*(unsigned int *)p = param_len[i];
+		p += sizeof(unsigned int);
+		memcpy(p, img_desc->authenticated_data[i].data.ptr,
+		       param_len[i]);
+		p += cert_cache_align(param_len[i]);
+	}
+
+	cert_cache->used += size;
+	flush_dcache_range((uintptr_t)cert_cache,
+			   sizeof(*cert_cache) + cert_cache->used);
+}
+#else /* IMAGE_BL1 */
+/*
+ * Check whether BL1 has handed over a certificate cache
+ */
+static void auth_cert_cache_init(void)
+{
+	cert_cache_valid = (cert_cache->magic == AUTH_CERT_CACHE_MAGIC) &&
+		(cert_cache->used <=
+		 (PLAT_AUTH_CERT_CACHE_SIZE - sizeof(*cert_cache)));
+
+	if (cert_cache_valid == 0) {
+		VERBOSE("No certificate verified by BL1\n");
+	}
+}
+
+/*
+ * Return the record of a certificate if it is identical to the one verified
+ * by BL1 for the same image, or NULL if it has to be verified
+ */
+static const auth_cert_cache_rec_t *auth_cert_cache_lookup(
+		const auth_img_desc_t *img_desc,
+		void *img_ptr, unsigned int img_len)
+{
+	const auth_cert_cache_rec_t *rec;
+	unsigned char hash[AUTH_CERT_CACHE_HASH_LEN];
+	unsigned int hash_len = sizeof(hash);
+
+	if (cert_cache_valid == 0) {
+		return NULL;
+	}
+
+	rec = auth_cert_cache_find(img_desc->img_id);
+	if (rec == NULL) {
+		return NULL;
+	}
+
+	if ((crypto_mod_calc_hash(img_ptr, img_len, hash, &hash_len) != 0) ||
+	    (hash_len != rec->hash_len) ||
+	    (memcmp(hash, rec->hash, hash_len) != 0)) {
+		return NULL;
+	}
+
+	return rec;
+}
+
+/*
+ * Authenticate a certificate from its record: check the NV counter recorded
+ * by BL1 against the platform and restore the parameters extracted from it.
+ *
+ * Return: 0 = success, Otherwise = error
+ */
+static int auth_cert_cache_restore(const auth_cert_cache_rec_t *rec,
+				   const auth_img_desc_t *img_desc)
+{
+	const auth_method_desc_t *auth_method;
+	const unsigned char *p = (const unsigned char *)(rec + 1);
+	size_t left = rec->size - sizeof(*rec);
+	unsigned int len;
+	int rc, i;
+
+	for (i = 0 ; i < AUTH_METHOD_NUM ; i++) {
+		auth_method = &img_desc->img_auth_methods[i];
+		if (auth_method->type == AUTH_METHOD_NV_CTR) {
+			rc = auth_nvctr_check(&auth_method->param.nv_ctr,
+					      img_desc, rec->nv_ctr);
+			return_if_error(rc);
+		}
+	}
+
+	for (i = 0 ; i < COT_MAX_VERIFIED_PARAMS ; i++) {
+		if (img_desc->authenticated_data[i].type_desc == NULL) {
+			continue;
+		}
+
+		/* The length and the padded parameter must be in the record */
+		if (left < sizeof(unsigned int)) {
+			return 1;
+		}
+		len = *(const unsigned int *)p;
+		p += sizeof(unsigned int);
+		left -= sizeof(unsigned int);
+		if ((len > img_desc->authenticated_data[i].data.len) ||
+		    (len > left) || (cert_cache_align(len) > left)) {
+			return 1;
+		}
+
+		memcpy(img_desc->authenticated_data[i].data.ptr, p, len);
+		p += cert_cache_align(len);
+		left -= cert_cache_align(len);
+	}
+
+	return 0;
+}
+#endif /* IMAGE_BL1 */
+#endif /* AUTH_CERT_CACHE */
 
 /*
  * Return the parent id in the output parameter '*parent_id'
@@ -333,6 +708,10 @@ void auth_mod_init(void)
 
 	/* Image parser module */
 	img_parser_init();
+
+#if AUTH_CERT_CACHE
+	auth_cert_cache_init();
+#endif
 }
 
 /*
@@ -348,11 +727,32 @@ int auth_mod_verify_img(unsigned int img_id,
 	const auth_method_desc_t *auth_method = NULL;
 	void *param_ptr;
 	unsigned int param_len;
+	unsigned int nv_ctr = 0U;
 	int rc, i;
+#if AUTH_CERT_CACHE && defined(IMAGE_BL1)
+	unsigned int param_lens[COT_MAX_VERIFIED_PARAMS];
+#endif
 
 	/* Get the image descriptor from the chain of trust */
 	img_desc = &cot_desc_ptr[img_id];
 
+#if AUTH_CERT_CACHE && !defined(IMAGE_BL1)
+	/* Skip the certificates verified by BL1 */
+	if (img_desc->img_type == IMG_CERT) {
+		const auth_cert_cache_rec_t *rec;
+
+		rec = auth_cert_cache_lookup(img_desc, img_ptr, img_len);
+		if (rec != NULL) {
+			rc = auth_cert_cache_restore(rec, img_desc);
+			return_if_error(rc);
+
+			auth_img_flags[img_desc->img_id] |=
+				IMG_FLAG_AUTHENTICATED;
+			return 0;
+		}
+	}
+#endif
+
 	/* Ask the parser to check the image integrity */
 	rc = img_parser_check_integrity(img_desc->img_type, img_ptr, img_len);
 	return_if_error(rc);
@@ -375,7 +775,7 @@ int auth_mod_verify_img(unsigned int img_id,
 			break;
 		case AUTH_METHOD_NV_CTR:
 			rc = auth_nvctr(&auth_method->param.nv_ctr,
-					img_desc, img_ptr, img_len);
+					img_desc, img_ptr, img_len, &nv_ctr);
 			break;
 		default:
 			/* Unknown authentication method */
@@ -406,7 +806,18 @@ int auth_mod_verify_img(unsigned int img_id,
 		/* Copy the parameter for later use */
 		memcpy((void *)img_desc->authenticated_data[i].data.ptr,
 				(void *)param_ptr, param_len);
+#if AUTH_CERT_CACHE && defined(IMAGE_BL1)
+		param_lens[i] = param_len;
+#endif
+	}
+
+#if AUTH_CERT_CACHE && defined(IMAGE_BL1)
+	/* Hand the certificate over to BL2 */
+	if (img_desc->img_type == IMG_CERT) {
+		auth_cert_cache_add(img_desc, img_ptr, img_len, nv_ctr,
+				    param_lens);
 	}
+#endif
 
 	/* Mark image as authenticated */
 	auth_img_flags[img_desc->img_id] |= IMG_FLAG_AUTHENTICATED;
@@ -5,6 +5,8 @@
  */
 
 #include <assert.h>
+#include <boot_profile.h>
+#include <cdefs.h>
 #include <crypto_mod.h>
 #include <debug.h>
 
@@ -68,6 +70,9 @@ int crypto_mod_verify_signature(void *data_ptr, unsigned int data_len,
 				void *sig_alg_ptr, unsigned int sig_alg_len,
 				void *pk_ptr, unsigned int pk_len)
 {
+	uint64_t start __unused;
+	int rc;
+
 	assert(data_ptr != NULL);
 	assert(data_len != 0);
 	assert(sig_ptr != NULL);
@@ -77,10 +82,14 @@ int crypto_mod_verify_signature(void *data_ptr, unsigned int data_len,
 	assert(pk_ptr != NULL);
 	assert(pk_len != 0);
 
-	return crypto_lib_desc.verify_signature(data_ptr, data_len,
-						sig_ptr, sig_len,
-						sig_alg_ptr, sig_alg_len,
-						pk_ptr, pk_len);
+	BOOT_PROF_START(start);
+	rc = crypto_lib_desc.verify_signature(data_ptr, data_len,
+					      sig_ptr, sig_len,
+					      sig_alg_ptr, sig_alg_len,
+					      pk_ptr, pk_len);
+	BOOT_PROF_END(BOOT_PROF_VERIFY_SIGNATURE, start, data_len);
+
+	return rc;
 }
 
 /*
@@ -94,11 +103,114 @@ int crypto_mod_verify_signature(void *data_ptr, unsigned int data_len,
 int crypto_mod_verify_hash(void *data_ptr, unsigned int data_len,
 			   void *digest_info_ptr, unsigned int digest_info_len)
 {
+	uint64_t start __unused;
+	int rc;
+
 	assert(data_ptr != NULL);
 	assert(data_len != 0);
 	assert(digest_info_ptr != NULL);
 	assert(digest_info_len != 0);
 
-	return crypto_lib_desc.verify_hash(data_ptr, data_len,
-					   digest_info_ptr, digest_info_len);
+	BOOT_PROF_START(start);
+	rc = crypto_lib_desc.verify_hash(data_ptr, data_len,
+					 digest_info_ptr, digest_info_len);
+	BOOT_PROF_END(BOOT_PROF_VERIFY_HASH, start, data_len);
+
+	return rc;
+}
+
+/*
+ * Start the incremental verification of a hash. The data is then passed in
+ * chunks to crypto_mod_hash_stream_update() and the result is obtained from
+ * crypto_mod_hash_stream_finish(), which must be called once the stream has
+ * been started successfully, even if the data could not be read entirely.
+ *
+ * Returns CRYPTO_ERR_UNKNOWN if the crypto library has no support for it.
+ *
+ * Parameters:
+ *
+ *   digest_info_ptr, digest_info_len: hash to be compared
+ */
+int crypto_mod_hash_stream_start(void *digest_info_ptr,
+				 unsigned int digest_info_len)
+{
+	assert(digest_info_ptr != NULL);
+	assert(digest_info_len != 0);
+
+	if (crypto_lib_desc.hash_stream_start == NULL) {
+		return CRYPTO_ERR_UNKNOWN;
+	}
+
+	return crypto_lib_desc.hash_stream_start(digest_info_ptr,
+						 digest_info_len);
+}
+
+/*
+ * Add data to the hash being verified
+ *
+ * Parameters:
+ *
+ *   data_ptr, data_len: next chunk of data to be hashed
+ */
+int crypto_mod_hash_stream_update(void *data_ptr, unsigned int data_len)
+{
+	uint64_t start __unused;
+	int rc;
+
+	assert(crypto_lib_desc.hash_stream_update != NULL);
+	assert(data_ptr != NULL);
+
+	if (data_len == 0) {
+		return CRYPTO_SUCCESS;
+	}
+
+	BOOT_PROF_START(start);
+	rc = crypto_lib_desc.hash_stream_update(data_ptr, data_len);
+	BOOT_PROF_END(BOOT_PROF_VERIFY_HASH, start, data_len);
+
+	return rc;
+}
+
+/*
+ * Compare the hash of the data passed so far with the expected one
+ */
+int crypto_mod_hash_stream_finish(void)
+{
+	assert(crypto_lib_desc.hash_stream_finish != NULL);
+
+	return crypto_lib_desc.hash_stream_finish();
+}
+
+/*
+ * Calculate the hash of some data
+ *
+ * Returns CRYPTO_ERR_UNKNOWN if the crypto library has no support for it.
+ *
+ * Parameters:
+ *
+ *   data_ptr, data_len: data to be hashed
+ *   hash_ptr: buffer where the hash is written
+ *   hash_len: size of the buffer, then size of the hash on success
+ */
+int crypto_mod_calc_hash(void *data_ptr, unsigned int data_len,
+			 void *hash_ptr, unsigned int *hash_len)
+{
+	uint64_t start __unused;
+	int rc;
+
+	assert(data_ptr != NULL);
+	assert(data_len != 0);
+	assert(hash_ptr != NULL);
+	assert(hash_len != NULL);
+
+	if (crypto_lib_desc.calc_hash == NULL) {
+		return CRYPTO_ERR_UNKNOWN;
+	}
+
+	BOOT_PROF_START(start);
+	rc = crypto_lib_desc.calc_hash(data_ptr, data_len,
+				       hash_ptr, hash_len);
+	BOOT_PROF_END(BOOT_PROF_VERIFY_HASH, start, data_len);
+
+	return rc;
 }
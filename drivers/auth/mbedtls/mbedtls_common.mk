@@ -88,9 +88,27 @@ else
     $(error "TF_MBEDTLS_KEY_ALG=${TF_MBEDTLS_KEY_ALG} not supported on mbed TLS")
 endif
 
+# Use the SHA-256 and SHA-512 instructions of the ARMv8 Cryptographic Extension
+# when the CPU implements them.
+TF_MBEDTLS_USE_ARMV8_SHA	?=	0
+ifeq (${TF_MBEDTLS_USE_ARMV8_SHA},1)
+    ifneq (${ARCH},aarch64)
+        $(error "TF_MBEDTLS_USE_ARMV8_SHA is only supported on AArch64")
+    endif
+    # The portable compression functions of mbed TLS are built again from
+    # the library sources as a fallback.
+    MBEDTLS_INC		+=	-I${MBEDTLS_DIR}
+    MBEDTLS_SOURCES	+=	drivers/auth/mbedtls/mbedtls_sha_armv8.c	\
+				drivers/auth/mbedtls/mbedtls_sha256_portable.c	\
+				drivers/auth/mbedtls/mbedtls_sha512_portable.c	\
+				drivers/auth/mbedtls/aarch64/sha2_armv8.S
+endif
+
 # Needs to be set to drive mbed TLS configuration correctly
+$(eval $(call assert_boolean,TF_MBEDTLS_USE_ARMV8_SHA))
 $(eval $(call add_define,TF_MBEDTLS_KEY_ALG_ID))
 $(eval $(call add_define,TF_MBEDTLS_HASH_ALG_ID))
+$(eval $(call add_define,TF_MBEDTLS_USE_ARMV8_SHA))
 
 
 $(eval $(call MAKE_LIB,mbedtls))
@@ -135,19 +135,18 @@ end2:
 }
 
 /*
- * Match a hash
+ * Parse the digest info and return the hash algorithm and the expected hash
  *
  * Digest info is passed in DER format following the ASN.1 structure detailed
  * above.
  */
-static int verify_hash(void *data_ptr, unsigned int data_len,
-		       void *digest_info_ptr, unsigned int digest_info_len)
+static int get_digest_info(void *digest_info_ptr, unsigned int digest_info_len,
+			   const mbedtls_md_info_t **md_info,
+			   unsigned char **hash)
 {
 	mbedtls_asn1_buf hash_oid, params;
 	mbedtls_md_type_t md_alg;
-	const mbedtls_md_info_t *md_info;
-	unsigned char *p, *end, *hash;
-	unsigned char data_hash[MBEDTLS_MD_MAX_SIZE];
+	unsigned char *p, *end;
 	size_t len;
 	int rc;
 
@@ -171,8 +170,8 @@ static int verify_hash(void *data_ptr, unsigned int data_len,
 		return CRYPTO_ERR_HASH;
 	}
 
-	md_info = mbedtls_md_info_from_type(md_alg);
-	if (md_info == NULL) {
+	*md_info = mbedtls_md_info_from_type(md_alg);
+	if (*md_info == NULL) {
 		return CRYPTO_ERR_HASH;
 	}
 
@@ -183,14 +182,36 @@ static int verify_hash(void *data_ptr, unsigned int data_len,
 	}
 
 	/* Length of hash must match the algorithm's size */
-	if (len != mbedtls_md_get_size(md_info)) {
+	if (len != mbedtls_md_get_size(*md_info)) {
 		return CRYPTO_ERR_HASH;
 	}
-	hash = p;
+	*hash = p;
+
+	return CRYPTO_SUCCESS;
+}
+
+/*
+ * Match a hash
+ *
+ * Digest info is passed in DER format following the ASN.1 structure detailed
+ * above.
+ */
+static int verify_hash(void *data_ptr, unsigned int data_len,
+		       void *digest_info_ptr, unsigned int digest_info_len)
+{
+	const mbedtls_md_info_t *md_info;
+	unsigned char *hash;
+	unsigned char data_hash[MBEDTLS_MD_MAX_SIZE];
+	int rc;
+
+	rc = get_digest_info(digest_info_ptr, digest_info_len, &md_info, &hash);
+	if (rc != CRYPTO_SUCCESS) {
+		return rc;
+	}
 
 	/* Calculate the hash of the data */
-	p = (unsigned char *)data_ptr;
-	rc = mbedtls_md(md_info, p, data_len, data_hash);
+	rc = mbedtls_md(md_info, (unsigned char *)data_ptr, data_len,
+			data_hash);
 	if (rc != 0) {
 		return CRYPTO_ERR_HASH;
 	}
@@ -204,7 +225,99 @@ static int verify_hash(void *data_ptr, unsigned int data_len,
 	return CRYPTO_SUCCESS;
 }
 
+/*
+ * Incremental hash verification. The expected hash is copied as the digest
+ * info may be overwritten while the data is being hashed.
+ */
+static mbedtls_md_context_t stream_ctx;
+static unsigned char stream_hash[MBEDTLS_MD_MAX_SIZE];
+static size_t stream_hash_len;
+
+static int hash_stream_start(void *digest_info_ptr,
+			     unsigned int digest_info_len)
+{
+	const mbedtls_md_info_t *md_info;
+	unsigned char *hash;
+	int rc;
+
+	rc = get_digest_info(digest_info_ptr, digest_info_len, &md_info, &hash);
+	if (rc != CRYPTO_SUCCESS) {
+		return rc;
+	}
+	stream_hash_len = mbedtls_md_get_size(md_info);
+	memcpy(stream_hash, hash, stream_hash_len);
+
+	mbedtls_md_init(&stream_ctx);
+	rc = mbedtls_md_setup(&stream_ctx, md_info, 0);
+	if (rc == 0) {
+		rc = mbedtls_md_starts(&stream_ctx);
+	}
+	if (rc != 0) {
+		mbedtls_md_free(&stream_ctx);
+		return CRYPTO_ERR_HASH;
+	}
+
+	return CRYPTO_SUCCESS;
+}
+
+static int hash_stream_update(void *data_ptr, unsigned int data_len)
+{
+	if (mbedtls_md_update(&stream_ctx, (unsigned char *)data_ptr,
+			      data_len) != 0) {
+		return CRYPTO_ERR_HASH;
+	}
+
+	return CRYPTO_SUCCESS;
+}
+
+static int hash_stream_finish(void)
+{
+	unsigned char data_hash[MBEDTLS_MD_MAX_SIZE];
+	int rc;
+
+	rc = mbedtls_md_finish(&stream_ctx, data_hash);
+	if (rc == 0) {
+		rc = memcmp(data_hash, stream_hash, stream_hash_len);
+	}
+	mbedtls_md_free(&stream_ctx);
+
+	return (rc == 0) ? CRYPTO_SUCCESS : CRYPTO_ERR_HASH;
+}
+
+/*
+ * Calculate a hash with the algorithm selected by TF_MBEDTLS_HASH_ALG_ID
+ */
+#if TF_MBEDTLS_HASH_ALG_ID == TF_MBEDTLS_SHA256
+#define CRYPTO_MD_ID		MBEDTLS_MD_SHA256
+#elif TF_MBEDTLS_HASH_ALG_ID == TF_MBEDTLS_SHA384
+#define CRYPTO_MD_ID		MBEDTLS_MD_SHA384
+#else
+#define CRYPTO_MD_ID		MBEDTLS_MD_SHA512
+#endif
+
+static int calc_hash(void *data_ptr, unsigned int data_len,
+		     void *hash_ptr, unsigned int *hash_len)
+{
+	const mbedtls_md_info_t *md_info;
+
+	md_info = mbedtls_md_info_from_type(CRYPTO_MD_ID);
+	if ((md_info == NULL) ||
+	    (mbedtls_md_get_size(md_info) > *hash_len)) {
+		return CRYPTO_ERR_HASH;
+	}
+
+	if (mbedtls_md(md_info, (unsigned char *)data_ptr, data_len,
+		       (unsigned char *)hash_ptr) != 0) {
+		return CRYPTO_ERR_HASH;
+	}
+	*hash_len = mbedtls_md_get_size(md_info);
+
+	return CRYPTO_SUCCESS;
+}
+
 /*
  * Register crypto library descriptor
  */
-REGISTER_CRYPTO_LIB(LIB_NAME, init, verify_signature, verify_hash);
+REGISTER_CRYPTO_LIB_HASH_STREAM(LIB_NAME, init, verify_signature, verify_hash,
+				hash_stream_start, hash_stream_update,
+				hash_stream_finish, calc_hash);
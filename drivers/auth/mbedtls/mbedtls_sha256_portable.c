@@ -0,0 +1,34 @@
+/*
+ * Copyright (c) 2018, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * Second build of the SHA-256 module of mbed TLS, without
+ * MBEDTLS_SHA256_PROCESS_ALT, so that mbedtls_sha_armv8.c can fall back to the
+ * portable compression function of mbed TLS, available here as
+ * mbedtls_sha256_process_c(). The other functions of this build are renamed so
+ * that they do not clash with the library, and are discarded by the linker.
+ */
+
+#include <mbedtls_config.h>
+
+#undef MBEDTLS_SHA256_PROCESS_ALT
+
+#define mbedtls_internal_sha256_process	mbedtls_sha256_process_c
+#define mbedtls_sha256_init		mbedtls_sha256_c_init
+#define mbedtls_sha256_free		mbedtls_sha256_c_free
+#define mbedtls_sha256_clone		mbedtls_sha256_c_clone
+#define mbedtls_sha256_starts		mbedtls_sha256_c_starts
+#define mbedtls_sha256_starts_ret	mbedtls_sha256_c_starts_ret
+#define mbedtls_sha256_update		mbedtls_sha256_c_update
+#define mbedtls_sha256_update_ret	mbedtls_sha256_c_update_ret
+#define mbedtls_sha256_finish		mbedtls_sha256_c_finish
+#define mbedtls_sha256_finish_ret	mbedtls_sha256_c_finish_ret
+#define mbedtls_sha256_process		mbedtls_sha256_c_process
+#define mbedtls_sha256			mbedtls_sha256_c
+#define mbedtls_sha256_ret		mbedtls_sha256_c_ret
+#define mbedtls_sha256_self_test	mbedtls_sha256_c_self_test
+
+#include <library/sha256.c>
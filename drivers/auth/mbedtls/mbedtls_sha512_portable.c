@@ -0,0 +1,35 @@
+/*
+ * Copyright (c) 2018, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * Second build of the SHA-512 module of mbed TLS, without
+ * MBEDTLS_SHA512_PROCESS_ALT, so that mbedtls_sha_armv8.c can fall back to the
+ * portable compression function of mbed TLS, available here as
+ * mbedtls_sha512_process_c(). See mbedtls_sha256_portable.c.
+ */
+
+#include <mbedtls_config.h>
+
+#if defined(MBEDTLS_SHA512_C)
+#undef MBEDTLS_SHA512_PROCESS_ALT
+
+#define mbedtls_internal_sha512_process	mbedtls_sha512_process_c
+#define mbedtls_sha512_init		mbedtls_sha512_c_init
+#define mbedtls_sha512_free		mbedtls_sha512_c_free
+#define mbedtls_sha512_clone		mbedtls_sha512_c_clone
+#define mbedtls_sha512_starts		mbedtls_sha512_c_starts
+#define mbedtls_sha512_starts_ret	mbedtls_sha512_c_starts_ret
+#define mbedtls_sha512_update		mbedtls_sha512_c_update
+#define mbedtls_sha512_update_ret	mbedtls_sha512_c_update_ret
+#define mbedtls_sha512_finish		mbedtls_sha512_c_finish
+#define mbedtls_sha512_finish_ret	mbedtls_sha512_c_finish_ret
+#define mbedtls_sha512_process		mbedtls_sha512_c_process
+#define mbedtls_sha512			mbedtls_sha512_c
+#define mbedtls_sha512_ret		mbedtls_sha512_c_ret
+#define mbedtls_sha512_self_test	mbedtls_sha512_c_self_test
+
+#include <library/sha512.c>
+#endif
@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2018, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <arch.h>
+#include <arch_helpers.h>
+#include <mbedtls_config.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* mbed TLS headers */
+#include <mbedtls/sha256.h>
+#if defined(MBEDTLS_SHA512_C)
+#include <mbedtls/sha512.h>
+#endif
+
+/*
+ * SHA-256 and SHA-512 compression functions for mbed TLS, selected with
+ * MBEDTLS_SHA256_PROCESS_ALT and MBEDTLS_SHA512_PROCESS_ALT. They use the
+ * instructions of the ARMv8 Cryptographic Extension when ID_AA64ISAR0_EL1
+ * reports them, and the portable functions of mbed TLS otherwise. All the
+ * hashes computed through mbed TLS, including the ones of the images, go
+ * through these functions.
+ */
+
+void sha256_block_armv8(uint32_t state[8], const unsigned char *data,
+			size_t blocks);
+void sha512_block_armv8(uint64_t state[8], const unsigned char *data,
+			size_t blocks);
+
+/* Defined by mbedtls_sha256_portable.c and mbedtls_sha512_portable.c */
+int mbedtls_sha256_process_c(mbedtls_sha256_context *ctx,
+			     const unsigned char data[64]);
+#if defined(MBEDTLS_SHA512_C)
+int mbedtls_sha512_process_c(mbedtls_sha512_context *ctx,
+			     const unsigned char data[128]);
+#endif
+
+/* Value of ID_AA64ISAR0_EL1.SHA2, read on first use */
+static unsigned int sha2_support;
+static bool sha2_support_read;
+
+static unsigned int get_sha2_support(void)
+{
+	if (!sha2_support_read) {
+		sha2_support = (unsigned int)((read_id_aa64isar0_el1() >>
+			ID_AA64ISAR0_SHA2_SHIFT) & ID_AA64ISAR0_SHA2_MASK);
+		sha2_support_read = true;
+	}
+
+	return sha2_support;
+}
+
+int mbedtls_internal_sha256_process(mbedtls_sha256_context *ctx,
+				    const unsigned char data[64])
+{
+	if (get_sha2_support() < ID_AA64ISAR0_SHA2_SHA256)
+		return mbedtls_sha256_process_c(ctx, data);
+
+	sha256_block_armv8(ctx->state, data, 1U);
+
+	return 0;
+}
+
+#if defined(MBEDTLS_SHA512_C)
+int mbedtls_internal_sha512_process(mbedtls_sha512_context *ctx,
+				    const unsigned char data[128])
+{
+	if (get_sha2_support() < ID_AA64ISAR0_SHA2_SHA512)
+		return mbedtls_sha512_process_c(ctx, data);
+
+	sha512_block_armv8(ctx->state, data, 1U);
+
+	return 0;
+}
+#endif /* MBEDTLS_SHA512_C */
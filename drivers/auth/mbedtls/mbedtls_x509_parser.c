@@ -15,6 +15,7 @@
 #include <arch_helpers.h>
 #include <assert.h>
 #include <img_parser_mod.h>
+#include <limits.h>
 #include <mbedtls_common.h>
 #include <stddef.h>
 #include <stdint.h>
@@ -23,11 +24,13 @@
 
 /* mbed TLS headers */
 #include <mbedtls/asn1.h>
-#include <mbedtls/oid.h>
 #include <mbedtls/platform.h>
 
-/* Maximum OID string length ("a.b.c.d.e.f ...") */
-#define MAX_OID_STR_LEN			64
+/* Maximum OID length, in bytes, once DER encoded */
+#define MAX_OID_DER_LEN			32
+
+/* Maximum number of extensions indexed in a certificate */
+#define MAX_CERT_EXTENSIONS		16
 
 #define LIB_NAME	"mbed TLS X509v3"
 
@@ -41,6 +44,15 @@ static mbedtls_asn1_buf pk;
 static mbedtls_asn1_buf sig_alg;
 static mbedtls_asn1_buf signature;
 
+/* Index of the X509v3 extensions, in the order they appear in the certificate */
+static struct {
+	mbedtls_asn1_buf oid;
+	mbedtls_asn1_buf data;
+} ext_index[MAX_CERT_EXTENSIONS];
+static unsigned int ext_count;
+/* First extension not in the index, NULL if all of them are indexed */
+static unsigned char *ext_unindexed;
+
 /*
  * Clear all static temporary variables.
  */
@@ -57,46 +69,131 @@ static void clear_temp_vars(void)
 	ZERO_AND_CLEAN(pk);
 	ZERO_AND_CLEAN(sig_alg);
 	ZERO_AND_CLEAN(signature);
+	ZERO_AND_CLEAN(ext_index);
+	ZERO_AND_CLEAN(ext_count);
+	ZERO_AND_CLEAN(ext_unindexed);
 
 #undef ZERO_AND_CLEAN
 }
 
+/*
+ * Encode an OID given as a numeric string ("a.b.c.d.e.f ...") with DER, without
+ * the tag and length.
+ */
+static int oid_str_to_der(const char *oid, unsigned char *der, size_t size,
+			  size_t *der_len)
+{
+	unsigned long arc, first = 0UL;
+	unsigned int n = 0U, i, arc_len;
+	size_t len = 0U;
+
+	while (*oid != '\0') {
+		if ((*oid < '0') || (*oid > '9')) {
+			return IMG_PARSER_ERR;
+		}
+		arc = 0UL;
+		while ((*oid >= '0') && (*oid <= '9')) {
+			unsigned long digit = (unsigned long)(*oid - '0');
+
+			/* Reject the arcs that do not fit in an unsigned long */
+			if (arc > ((ULONG_MAX - digit) / 10UL)) {
+				return IMG_PARSER_ERR;
+			}
+			arc = (arc * 10UL) + digit;
+			oid++;
+		}
+		if (*oid == '.') {
+			oid++;
+		} else if (*oid != '\0') {
+			return IMG_PARSER_ERR;
+		}
+
+		/* The first two arcs are encoded together */
+		if (n++ == 0U) {
+			/* The first arc is 0, 1 or 2 */
+			if (arc > 2UL) {
+				return IMG_PARSER_ERR;
+			}
+			first = arc;
+			continue;
+		}
+		if (n == 2U) {
+			if (arc > (ULONG_MAX - (first * 40UL))) {
+				return IMG_PARSER_ERR;
+			}
+			arc += first * 40UL;
+		}
+
+		/* Base 128, most significant group first */
+		arc_len = 1U;
+		while (((7U * arc_len) < (sizeof(arc) * 8U)) &&
+		       ((arc >> (7U * arc_len)) != 0UL)) {
+			arc_len++;
+		}
+		if ((len + arc_len) > size) {
+			return IMG_PARSER_ERR;
+		}
+		for (i = arc_len; i > 0U; i--) {
+			der[len++] = (unsigned char)((arc >> (7U * (i - 1U))) &
+						     0x7fUL) |
+				     ((i > 1U) ? 0x80U : 0U);
+		}
+	}
+
+	if (n < 2U) {
+		return IMG_PARSER_ERR;
+	}
+	*der_len = len;
+
+	return IMG_PARSER_OK;
+}
+
 /*
  * Get X509v3 extension
  *
- * Global variable 'v3_ext' must point to the extensions region
- * in the certificate. No need to check for errors since the image has passed
- * the integrity check.
+ * The extensions of the certificate have been indexed by the integrity check,
+ * so the certificate is not parsed again. If the certificate has more than
+ * MAX_CERT_EXTENSIONS extensions, the ones that are not in the index are
+ * walked through. No need to check for errors since the image has passed the
+ * integrity check.
  */
 static int get_ext(const char *oid, void **ext, unsigned int *ext_len)
 {
-	int oid_len;
-	size_t len;
-	unsigned char *end_ext_data, *end_ext_octet;
-	unsigned char *p;
-	const unsigned char *end;
-	char oid_str[MAX_OID_STR_LEN];
+	unsigned char oid_der[MAX_OID_DER_LEN];
+	size_t oid_len, len;
+	unsigned char *p, *end, *end_ext_data;
 	mbedtls_asn1_buf extn_oid;
 	int is_critical;
+	unsigned int i;
 
 	assert(oid != NULL);
 
-	p = v3_ext.p;
-	end = v3_ext.p + v3_ext.len;
+	if (oid_str_to_der(oid, oid_der, sizeof(oid_der), &oid_len) !=
+	    IMG_PARSER_OK) {
+		return IMG_PARSER_ERR;
+	}
+
+	for (i = 0U; i < ext_count; i++) {
+		if ((ext_index[i].oid.len == oid_len) &&
+		    (memcmp(ext_index[i].oid.p, oid_der, oid_len) == 0)) {
+			*ext = (void *)ext_index[i].data.p;
+			*ext_len = (unsigned int)ext_index[i].data.len;
+			return IMG_PARSER_OK;
+		}
+	}
 
-	mbedtls_asn1_get_tag(&p, end, &len, MBEDTLS_ASN1_CONSTRUCTED |
-			     MBEDTLS_ASN1_SEQUENCE);
+	if (ext_unindexed == NULL) {
+		return IMG_PARSER_ERR_NOT_FOUND;
+	}
 
+	p = ext_unindexed;
+	end = v3_ext.p + v3_ext.len;
 	while (p < end) {
-		zeromem(&extn_oid, sizeof(extn_oid));
-		is_critical = 0; /* DEFAULT FALSE */
-
 		mbedtls_asn1_get_tag(&p, end, &len, MBEDTLS_ASN1_CONSTRUCTED |
 				     MBEDTLS_ASN1_SEQUENCE);
 		end_ext_data = p + len;
 
 		/* Get extension ID */
-		extn_oid.tag = *p;
 		mbedtls_asn1_get_tag(&p, end, &extn_oid.len, MBEDTLS_ASN1_OID);
 		extn_oid.p = p;
 		p += extn_oid.len;
@@ -107,23 +204,16 @@ static int get_ext(const char *oid, void **ext, unsigned int *ext_len)
 		/* Extension data */
 		mbedtls_asn1_get_tag(&p, end_ext_data, &len,
 				     MBEDTLS_ASN1_OCTET_STRING);
-		end_ext_octet = p + len;
 
-		/* Detect requested extension */
-		oid_len = mbedtls_oid_get_numeric_string(oid_str,
-							 MAX_OID_STR_LEN,
-							 &extn_oid);
-		if (oid_len == MBEDTLS_ERR_OID_BUF_TOO_SMALL) {
-			return IMG_PARSER_ERR;
-		}
-		if ((oid_len == strlen(oid_str)) && !strcmp(oid, oid_str)) {
+		if ((extn_oid.len == oid_len) &&
+		    (memcmp(extn_oid.p, oid_der, oid_len) == 0)) {
 			*ext = (void *)p;
 			*ext_len = (unsigned int)len;
 			return IMG_PARSER_OK;
 		}
 
-		/* Next */
-		p = end_ext_octet;
+		/* Next extension */
+		p = end_ext_data;
 	}
 
 	return IMG_PARSER_ERR_NOT_FOUND;
@@ -143,8 +233,8 @@ static int cert_parse(void *img, unsigned int img_len)
 {
 	int ret, is_critical;
 	size_t len;
-	unsigned char *p, *end, *crt_end;
-	mbedtls_asn1_buf sig_alg1, sig_alg2;
+	unsigned char *p, *end, *crt_end, *ext_start;
+	mbedtls_asn1_buf sig_alg1, sig_alg2, extn_oid;
 
 	p = (unsigned char *)img;
 	len = img_len;
@@ -309,9 +399,13 @@ static int cert_parse(void *img, unsigned int img_len)
 	v3_ext.len = (p + len) - v3_ext.p;
 
 	/*
-	 * Check extensions integrity
+	 * Check extensions integrity and index the first MAX_CERT_EXTENSIONS
+	 * of them
 	 */
+	ext_count = 0U;
+	ext_unindexed = NULL;
 	while (p < end) {
+		ext_start = p;
 		ret = mbedtls_asn1_get_tag(&p, end, &len,
 					   MBEDTLS_ASN1_CONSTRUCTED |
 					   MBEDTLS_ASN1_SEQUENCE);
@@ -324,6 +418,8 @@ static int cert_parse(void *img, unsigned int img_len)
 		if (ret != 0) {
 			return IMG_PARSER_ERR_FORMAT;
 		}
+		extn_oid.p = p;
+		extn_oid.len = len;
 		p += len;
 
 		/* Get optional critical */
@@ -338,6 +434,15 @@ static int cert_parse(void *img, unsigned int img_len)
 		if (ret != 0) {
 			return IMG_PARSER_ERR_FORMAT;
 		}
+		if (ext_count < MAX_CERT_EXTENSIONS) {
+			ext_index[ext_count].oid.p = extn_oid.p;
+			ext_index[ext_count].oid.len = extn_oid.len;
+			ext_index[ext_count].data.p = p;
+			ext_index[ext_count].data.len = len;
+			ext_count++;
+		} else if (ext_unindexed == NULL) {
+			ext_unindexed = ext_start;
+		}
 		p += len;
 	}
 
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2016-2017, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2016-2018, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -19,6 +19,9 @@ typedef struct {
 	uintptr_t		base;
 	size_t			file_pos;
 	size_t			size;
+	/* Device data held in the buffer, buf_len bytes from offset buf_pos */
+	size_t			buf_pos;
+	size_t			buf_len;
 } block_dev_state_t;
 
 #define is_power_of_2(x)	((x != 0) && ((x & (x - 1)) == 0))
@@ -79,6 +82,26 @@ static int find_first_block_state(const io_block_dev_spec_t *dev_spec,
 	return result;
 }
 
+/*
+ * Forget the device data held in a buffer, for all the devices whose buffer
+ * overlaps it, or in all the buffers if 'buf' is NULL.
+ */
+static void invalidate_buffer(const io_block_spec_t *buf)
+{
+	const io_block_spec_t *other;
+
+	for (int index = 0; index < MAX_IO_BLOCK_DEVICES; ++index) {
+		if (state_pool[index].dev_spec == NULL)
+			continue;
+
+		other = &(state_pool[index].dev_spec->buffer);
+		if ((buf == NULL) ||
+		    ((other->offset < (buf->offset + buf->length)) &&
+		     (buf->offset < (other->offset + other->length))))
+			state_pool[index].buf_len = 0;
+	}
+}
+
 /* Allocate a device info from the pool and return a pointer to it */
 static int allocate_dev_info(io_dev_info_t **dev_info)
 {
@@ -236,6 +259,15 @@ static int block_seek(io_entity_t *entity, int mode, ssize_t offset)
  *
  * Additionally, the IO driver has an underlying buffer that is at least
  * one block-size and may be big enough to allow.
+ *
+ * The data read into the buffer is kept, so that reads of data which is still
+ * in the buffer do not access the device. When the buffer has to be filled,
+ * at least 'read_ahead' bytes are read, if the file is big enough, so that
+ * small sequential reads (e.g. the table of contents of a FIP) are served from
+ * memory. If the device supports it (IO_BLOCK_DIRECT_READ), the whole blocks
+ * of the transfer which are not in the buffer are read with a single request
+ * straight into the destination buffer, and only the unaligned head and tail
+ * go through the buffer.
  */
 static int block_read(io_entity_t *entity, uintptr_t buffer, size_t length,
 		      size_t *length_read)
@@ -245,6 +277,9 @@ static int block_read(io_entity_t *entity, uintptr_t buffer, size_t length,
 	io_block_ops_t *ops;
 	int lba;
 	size_t block_size, left;
+	size_t read_ahead;
+	size_t pos;     /* device offset of the next byte to be read */
+	size_t end;     /* device offset of the end of the file */
 	size_t nbytes;  /* number of bytes read in one iteration */
 	size_t request; /* number of requested bytes in one iteration */
 	size_t count;   /* number of bytes already read */
@@ -254,21 +289,18 @@ static int block_read(io_entity_t *entity, uintptr_t buffer, size_t length,
 	 */
 	size_t skip;
 
-	/*
-	 * number of trailing bytes between the last byte
-	 * to be read and the end of the block
-	 */
-	size_t padding;
-
 	assert(entity->info != (uintptr_t)NULL);
 	cur = (block_dev_state_t *)entity->info;
 	ops = &(cur->dev_spec->ops);
 	buf = &(cur->dev_spec->buffer);
 	block_size = cur->dev_spec->block_size;
+	read_ahead = cur->dev_spec->read_ahead;
 	assert((length <= cur->size) &&
 	       (length > 0) &&
 	       (ops->read != 0));
 
+	end = cur->base + cur->size;
+
 	/*
 	 * We don't know the number of bytes that we are going
 	 * to read in every iteration, because it will depend
@@ -280,57 +312,74 @@ static int block_read(io_entity_t *entity, uintptr_t buffer, size_t length,
 		 * We must only request operations aligned to the block
 		 * size. Therefore if file_pos is not block-aligned,
 		 * we have to request the operation to start at the
-		 * previous block boundary and skip the leading bytes. And
-		 * similarly, the number of bytes requested must be a
-		 * block size multiple
+		 * previous block boundary and skip the leading bytes.
 		 */
-		skip = cur->file_pos & (block_size - 1);
+		pos = cur->base + cur->file_pos;
+		skip = pos & (block_size - 1);
 
 		/*
 		 * Calculate the block number containing file_pos
 		 * - e.g. block 3.
 		 */
-		lba = (cur->file_pos + cur->base) / block_size;
+		lba = pos / block_size;
+
+		if ((pos < cur->buf_pos) ||
+		    (pos >= (cur->buf_pos + cur->buf_len))) {
+			if (((cur->dev_spec->flags & IO_BLOCK_DIRECT_READ) != 0U) &&
+			    (skip == 0) && (left >= block_size)) {
+				/*
+				 * Read all the whole blocks left with a single
+				 * request, straight into the user buffer.
+				 */
+				request = left & ~(block_size - 1);
+				nbytes = ops->read(lba, buffer + count, request);
+				if ((nbytes == 0) || (nbytes > request))
+					return -EIO;
+
+				cur->file_pos += nbytes;
+				count += nbytes;
+				continue;
+			}
 
-		if (skip + left > buf->length) {
-			/*
-			 * The underlying read buffer is too small to
-			 * read all the required data - limit to just
-			 * fill the buffer, and then read again.
-			 */
-			request = buf->length;
-		} else {
 			/*
-			 * The underlying read buffer is big enough to
-			 * read all the required data. Calculate the
-			 * number of bytes to read to align with the
-			 * block size.
+			 * Read the blocks containing the requested data into
+			 * the buffer, and the following ones up to the
+			 * read-ahead size without going past the end of the
+			 * file. The number of bytes requested must be a block
+			 * size multiple and fit in the buffer.
 			 */
 			request = skip + left;
-			request = (request + (block_size - 1)) & ~(block_size - 1);
-		}
-		request = ops->read(lba, buf->offset, request);
+			if ((request < read_ahead) && (pos < end)) {
+				request = MIN(read_ahead, end - (pos - skip));
+				request = MAX(request, skip + left);
+			}
+			request = round_up(request, block_size);
+			request = MIN(request, buf->length);
 
-		if (request <= skip) {
-			/*
-			 * We couldn't read enough bytes to jump over
-			 * the skip bytes, so we should have to read
-			 * again the same block, thus generating
-			 * the same error.
-			 */
-			return -EIO;
+			invalidate_buffer(buf);
+			request = ops->read(lba, buf->offset, request);
+
+			if (request <= skip) {
+				/*
+				 * We couldn't read enough bytes to jump over
+				 * the skip bytes, so we should have to read
+				 * again the same block, thus generating
+				 * the same error.
+				 */
+				return -EIO;
+			}
+
+			cur->buf_pos = pos - skip;
+			cur->buf_len = request;
 		}
 
 		/*
-		 * Need to remove skip and padding bytes,if any, from
-		 * the read data when copying to the user buffer.
+		 * Copy the requested bytes held in the buffer, leaving out
+		 * the skip and padding bytes, to the user buffer.
 		 */
-		nbytes = request - skip;
-		padding = (nbytes > left) ? nbytes - left : 0;
-		nbytes -= padding;
-
+		nbytes = MIN(left, cur->buf_pos + cur->buf_len - pos);
 		memcpy((void *)(buffer + count),
-		       (void *)(buf->offset + skip),
+		       (void *)(buf->offset + (pos - cur->buf_pos)),
 		       nbytes);
 
 		cur->file_pos += nbytes;
@@ -381,6 +430,12 @@ static int block_write(io_entity_t *entity, const uintptr_t buffer,
 	       (ops->read != 0) &&
 	       (ops->write != 0));
 
+	/*
+	 * The buffer is used to prepare the blocks to be written, and the
+	 * blocks may be held in the buffer of another device.
+	 */
+	invalidate_buffer(NULL);
+
 	/*
 	 * We don't know the number of bytes that we are going
 	 * to write in every iteration, because it will depend
@@ -6,6 +6,8 @@
 
 #include <assert.h>
 #include <bl_common.h>
+#include <boot_profile.h>
+#include <cdefs.h>
 #include <debug.h>
 #include <errno.h>
 #include <firmware_image_package.h>
@@ -23,6 +25,15 @@
 #define MAX_FIP_DEVICES		1
 #endif
 
+/*
+ * Number of TOC entries kept in memory, 0 to always look up the backend. The
+ * default is enough for all the images and certificates of a Trusted Board Boot
+ * FIP.
+ */
+#ifndef FIP_TOC_INDEX_ENTRIES
+#define FIP_TOC_INDEX_ENTRIES	32
+#endif
+
 /* Useful for printing UUIDs when debugging.*/
 #define PRINT_UUID2(x)								\
 	"%08x-%04hx-%04hx-%02hhx%02hhx-%02hhx%02hhx%02hhx%02hhx%02hhx%02hhx",	\
@@ -64,6 +75,31 @@ static io_dev_info_t dev_info_pool[MAX_FIP_DEVICES];
 /* Track number of allocated fip devices */
 static unsigned int fip_dev_count;
 
+#if FIP_TOC_INDEX_ENTRIES > 0
+/*
+ * Index of the Table of Contents, built by fip_dev_init() so that files can be
+ * found without reading the TOC from the backend on every open. The index can
+ * only be used between a successful fip_dev_init() and fip_dev_close(), and
+ * the TOC is read again by every fip_dev_init() as the FIP may have changed
+ * in the meantime. If the TOC does not fit in the index, files which are not in
+ * the index are looked up in the backend.
+ */
+typedef struct {
+	uuid_t uuid;
+	uint64_t offset_address;
+	uint64_t size;
+} toc_index_entry_t;
+
+static struct {
+	uintptr_t dev_handle;
+	uintptr_t image_spec;
+	unsigned int valid;
+	unsigned int complete;
+	unsigned int num_entries;
+	toc_index_entry_t entries[FIP_TOC_INDEX_ENTRIES];
+} toc_index;
+#endif
+
 /* Firmware Image Package driver functions */
 static int fip_dev_open(const uintptr_t dev_spec, io_dev_info_t **dev_info);
 static int fip_file_open(io_dev_info_t *dev_info, const uintptr_t spec,
@@ -94,6 +130,89 @@ static inline int is_valid_header(fip_toc_header_t *header)
 }
 
 
+#if FIP_TOC_INDEX_ENTRIES > 0
+/* Return 1 if the TOC index has been built from the current backend. */
+static int is_toc_index_valid(void)
+{
+	return ((toc_index.valid != 0U) &&
+		(toc_index.dev_handle == backend_dev_handle) &&
+		(toc_index.image_spec == backend_image_spec)) ? 1 : 0;
+}
+
+/*
+ * Build the TOC index from the entries following the FIP header, which must
+ * have just been read from 'backend_handle'. On failure the index is not used
+ * and files are looked up in the backend.
+ */
+static void build_toc_index(uintptr_t backend_handle)
+{
+	fip_toc_entry_t entry;
+	toc_index_entry_t *index_entry;
+	size_t bytes_read;
+	int result;
+
+	toc_index.valid = 0U;
+	toc_index.complete = 0U;
+	toc_index.num_entries = 0U;
+
+	for (;;) {
+		result = io_read(backend_handle, (uintptr_t)&entry,
+				 sizeof(entry), &bytes_read);
+		if ((result != 0) || (bytes_read != sizeof(entry))) {
+			WARN("Failed to read FIP (%i)\n", result);
+			return;
+		}
+
+		if (compare_uuids(&entry.uuid, &uuid_null) == 0) {
+			toc_index.complete = 1U;
+			break;
+		}
+
+		if (toc_index.num_entries == (unsigned int)FIP_TOC_INDEX_ENTRIES) {
+			VERBOSE("FIP TOC partially indexed\n");
+			break;
+		}
+
+		index_entry = &toc_index.entries[toc_index.num_entries++];
+		index_entry->uuid = entry.uuid;
+		index_entry->offset_address = entry.offset_address;
+		index_entry->size = entry.size;
+	}
+
+	toc_index.dev_handle = backend_dev_handle;
+	toc_index.image_spec = backend_image_spec;
+	toc_index.valid = 1U;
+}
+
+/*
+ * Look up a file in the TOC index. Returns 0 and fills 'entry' if it is found,
+ * -ENOENT if it is not in the FIP, or -EAGAIN if the backend must be searched.
+ */
+static int find_toc_index_entry(const uuid_t *uuid, fip_toc_entry_t *entry)
+{
+	const toc_index_entry_t *index_entry;
+	unsigned int i;
+
+	if (is_toc_index_valid() == 0) {
+		return -EAGAIN;
+	}
+
+	for (i = 0U; i < toc_index.num_entries; i++) {
+		index_entry = &toc_index.entries[i];
+		if (compare_uuids(&index_entry->uuid, uuid) == 0) {
+			entry->uuid = index_entry->uuid;
+			entry->offset_address = index_entry->offset_address;
+			entry->size = index_entry->size;
+			entry->flags = 0U;
+			return 0;
+		}
+	}
+
+	return (toc_index.complete != 0U) ? -ENOENT : -EAGAIN;
+}
+#endif /* FIP_TOC_INDEX_ENTRIES > 0 */
+
+
 /* Identify the device type as a virtual driver */
 static io_type_t device_type_fip(void)
 {
@@ -220,6 +339,10 @@ static int fip_dev_init(io_dev_info_t *dev_info, const uintptr_t init_params)
 	fip_toc_header_t header;
 	size_t bytes_read;
 
+#if FIP_TOC_INDEX_ENTRIES > 0
+	toc_index.valid = 0U;
+#endif
+
 	/* Obtain a reference to the image by querying the platform layer */
 	result = plat_get_image_source(image_id, &backend_dev_handle,
 				       &backend_image_spec);
@@ -247,6 +370,9 @@ static int fip_dev_init(io_dev_info_t *dev_info, const uintptr_t init_params)
 			result = -ENOENT;
 		} else {
 			VERBOSE("FIP header looks OK.\n");
+#if FIP_TOC_INDEX_ENTRIES > 0
+			build_toc_index(backend_handle);
+#endif
 		}
 	}
 
@@ -265,6 +391,11 @@ static int fip_dev_close(io_dev_info_t *dev_info)
 	backend_dev_handle = (uintptr_t)NULL;
 	backend_image_spec = (uintptr_t)NULL;
 
+#if FIP_TOC_INDEX_ENTRIES > 0
+	/* The FIP may change before the device is opened again */
+	toc_index.valid = 0U;
+#endif
+
 	return free_dev_info(dev_info);
 }
 
@@ -278,10 +409,13 @@ static int fip_file_open(io_dev_info_t *dev_info, const uintptr_t spec,
 	const io_uuid_spec_t *uuid_spec = (io_uuid_spec_t *)spec;
 	size_t bytes_read;
 	int found_file = 0;
+	uint64_t start __unused;
 
 	assert(uuid_spec != NULL);
 	assert(entity != NULL);
 
+	BOOT_PROF_START(start);
+
 	/* Can only have one file open at a time for the moment. We need to
 	 * track state like file cursor position. We know the header lives at
 	 * offset zero, so this entry should never be zero for an active file.
@@ -293,6 +427,19 @@ static int fip_file_open(io_dev_info_t *dev_info, const uintptr_t spec,
 		return -ENOMEM;
 	}
 
+#if FIP_TOC_INDEX_ENTRIES > 0
+	/* Try to find the file without accessing the backend */
+	result = find_toc_index_entry(&uuid_spec->uuid, &current_file.entry);
+	if (result == 0) {
+		current_file.file_pos = 0;
+		entity->info = (uintptr_t)&current_file;
+		goto fip_file_open_exit;
+	} else if (result == -ENOENT) {
+		current_file.entry.offset_address = 0;
+		goto fip_file_open_exit;
+	}
+#endif
+
 	/* Attempt to access the FIP image */
 	result = io_open(backend_dev_handle, backend_image_spec,
 			 &backend_handle);
@@ -345,6 +492,7 @@ static int fip_file_open(io_dev_info_t *dev_info, const uintptr_t spec,
 	io_close(backend_handle);
 
  fip_file_open_exit:
+	BOOT_PROF_END(BOOT_PROF_FIP_OPEN, start, 0U);
 	return result;
 }
 
@@ -27,6 +27,9 @@ static const io_dev_info_t *devices[MAX_IO_DEVICES];
 /* Number of currently registered devices */
 static unsigned int dev_count;
 
+/* Function called by the drivers while they wait for a transfer, or NULL */
+static io_idle_handler_t idle_handler;
+
 /* Extra validation functions only used when asserts are enabled */
 #if ENABLE_ASSERTIONS
 
@@ -333,3 +336,23 @@ int io_close(uintptr_t handle)
 
 	return result;
 }
+
+
+/* Register the function called while a driver waits for a transfer */
+void io_register_idle_handler(io_idle_handler_t handler)
+{
+	idle_handler = handler;
+}
+
+
+/*
+ * Called by the drivers while they wait for a transfer to complete. Returns 0
+ * if there is nothing to do, in which case the driver may wait as usual.
+ */
+int io_idle(void)
+{
+	if (idle_handler == NULL)
+		return 0;
+
+	return idle_handler();
+}
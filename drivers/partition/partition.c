@@ -5,6 +5,8 @@
  */
 
 #include <assert.h>
+#include <boot_profile.h>
+#include <cdefs.h>
 #include <debug.h>
 #include <gpt.h>
 #include <io_storage.h>
@@ -147,8 +149,11 @@ int load_partition_table(unsigned int image_id)
 {
 	uintptr_t dev_handle, image_handle, image_spec = 0;
 	mbr_entry_t mbr_entry;
+	uint64_t start __unused;
 	int result;
 
+	BOOT_PROF_START(start);
+
 	result = plat_get_image_source(image_id, &dev_handle, &image_spec);
 	if (result != 0) {
 		WARN("Failed to obtain reference to image id=%u (%i)\n",
@@ -180,6 +185,7 @@ int load_partition_table(unsigned int image_id)
 	}
 exit:
 	io_close(image_handle);
+	BOOT_PROF_END(BOOT_PROF_GPT_LOAD, start, 0U);
 	return result;
 }
 
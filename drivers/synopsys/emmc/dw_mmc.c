@@ -11,6 +11,7 @@
 #include <delay_timer.h>
 #include <dw_mmc.h>
 #include <errno.h>
+#include <io_storage.h>
 #include <mmc.h>
 #include <mmio.h>
 #include <string.h>
@@ -225,7 +226,7 @@ static int dw_send_cmd(struct mmc_cmd *cmd)
 {
 	unsigned int op, data, err_mask;
 	uintptr_t base;
-	int timeout;
+	int timeout, busy;
 
 	assert(cmd);
 
@@ -288,14 +289,20 @@ static int dw_send_cmd(struct mmc_cmd *cmd)
 		   INT_DCRC | INT_DRT | INT_SBE;
 	timeout = TIMEOUT;
 	do {
-		udelay(500);
+		/*
+		 * Let the boot image work while the data is transferred. The
+		 * timeout only counts the time spent waiting.
+		 */
+		busy = io_idle();
+		if (busy == 0)
+			udelay(500);
 		data = mmio_read_32(base + DWMMC_RINTSTS);
 
 		if (data & err_mask)
 			return -EIO;
 		if (data & INT_DTO)
 			break;
-		if (--timeout == 0) {
+		if ((busy == 0) && (--timeout == 0)) {
 			ERROR("%s, RINTSTS:0x%x\n", __func__, data);
 			panic();
 		}
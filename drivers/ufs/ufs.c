@@ -10,6 +10,7 @@
 #include <delay_timer.h>
 #include <endian.h>
 #include <errno.h>
+#include <io_storage.h>
 #include <mmio.h>
 #include <platform_def.h>
 #include <stdint.h>
@@ -423,6 +424,8 @@ static int ufs_check_resp(utp_utrd_t *utrd, int trans_type)
 	inv_dcache_range((uintptr_t)hd, UFS_DESC_SIZE);
 	inv_dcache_range((uintptr_t)utrd, sizeof(utp_utrd_t));
 	do {
+		/* Let the boot image work while the request completes */
+		(void)io_idle();
 		data = mmio_read_32(ufs_params.reg_base + IS);
 		if ((data & ~(UFS_INT_UCCS | UFS_INT_UTRCS)) != 0)
 			return -EIO;
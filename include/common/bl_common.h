@@ -34,6 +34,11 @@
 
 #define IMAGE_ATTRIB_SKIP_LOADING	U(0x02)
 #define IMAGE_ATTRIB_PLAT_SETUP		U(0x04)
+/*
+ * The image may be loaded while the previous image is authenticated, before
+ * the previous image is post-processed. See BL2_PIPELINED_LOAD.
+ */
+#define IMAGE_ATTRIB_PIPELINE		U(0x08)
 
 #define INVALID_IMAGE_ID		U(0xFFFFFFFF)
 
@@ -215,6 +220,13 @@ int is_mem_free(uintptr_t free_base, size_t free_size,
 
 int load_auth_image(unsigned int image_id, image_info_t *image_data);
 
+#if BL2_PIPELINED_LOAD
+int load_image_pipelined(unsigned int image_id, image_info_t *image_data);
+void auth_image_pipelined_start(unsigned int image_id,
+				image_info_t *image_data);
+int auth_image_pipelined_finish(void);
+#endif
+
 #else
 
 int load_image(meminfo_t *mem_layout,
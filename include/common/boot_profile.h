@@ -0,0 +1,54 @@
+/*
+ * Copyright (c) 2018, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef __BOOT_PROFILE_H__
+#define __BOOT_PROFILE_H__
+
+/* Hot paths of the boot flow that can be timed */
+#define BOOT_PROF_IMAGE_LOAD		0
+#define BOOT_PROF_IMAGE_AUTH		1
+#define BOOT_PROF_DECOMPRESS		2
+#define BOOT_PROF_XLAT_INIT		3
+#define BOOT_PROF_GPT_LOAD		4
+#define BOOT_PROF_FIP_OPEN		5
+#define BOOT_PROF_VERIFY_SIGNATURE	6
+#define BOOT_PROF_VERIFY_HASH		7
+#define BOOT_PROF_XLAT_MAP		8
+#define BOOT_PROF_TOTAL_IDS		9
+
+#ifndef __ASSEMBLY__
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if ENABLE_BOOT_PROFILING
+
+uint64_t boot_prof_timestamp(void);
+void boot_prof_record(unsigned int id, uint64_t start, size_t bytes);
+void boot_prof_report(void);
+
+/*
+ * Time the code between BOOT_PROF_START() and BOOT_PROF_END() and account it
+ * against the probe 'id', along with the number of bytes that were processed.
+ * The start time is stored in '_var', a uint64_t declared by the caller with
+ * the __unused attribute, as it is not used when profiling is disabled.
+ */
+#define BOOT_PROF_START(_var)		((_var) = boot_prof_timestamp())
+#define BOOT_PROF_END(_id, _var, _bytes)	\
+	boot_prof_record((_id), (_var), (_bytes))
+#define BOOT_PROF_REPORT()		boot_prof_report()
+
+#else
+
+#define BOOT_PROF_START(_var)
+#define BOOT_PROF_END(_id, _var, _bytes)
+#define BOOT_PROF_REPORT()
+
+#endif /* ENABLE_BOOT_PROFILING */
+
+#endif /* __ASSEMBLY__ */
+
+#endif /* __BOOT_PROFILE_H__ */
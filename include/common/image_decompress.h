@@ -21,4 +21,20 @@ void image_decompress_init(uintptr_t buf_base, uint32_t buf_size,
 void image_decompress_prepare(struct image_info *info);
 int image_decompress(struct image_info *info);
 
+#if STREAM_IMAGE_DECOMPRESS
+/* Decompressor fed with the compressed data as it is read */
+typedef struct decompressor_stream {
+	int (*start)(uintptr_t out_buf, size_t out_len,
+		     uintptr_t work_buf, size_t work_len);
+	int (*update)(uintptr_t in_buf, size_t in_len);
+	int (*finish)(uintptr_t *out_buf);
+} decompressor_stream_t;
+
+void image_decompress_init_stream(uintptr_t buf_base, uint32_t buf_size,
+				  const decompressor_stream_t *decompressor);
+int image_decompress_is_streamed(const struct image_info *info);
+int image_decompress_read(uintptr_t image_handle, struct image_info *info,
+			  size_t image_size, size_t *bytes_read);
+#endif
+
 #endif /* __IMAGE_DECOMPRESS_H___ */
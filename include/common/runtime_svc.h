@@ -31,6 +31,27 @@
 #endif /* AARCH32 */
 #define SIZEOF_RT_SVC_DESC	(1 << RT_SVC_SIZE_LOG2)
 
+/*
+ * Constants to allow the assembler access a runtime service function
+ * descriptor. Only the AArch64 SMC handler does the lookup in assembly.
+ */
+#ifndef AARCH32
+#define RT_SVC_FID_SIZE_LOG2	4
+#define RT_SVC_FID_DESC_HANDLE	8
+#define SIZEOF_RT_SVC_FID_DESC	(1 << RT_SVC_FID_SIZE_LOG2)
+#endif
+
+/*
+ * Geometry of the function dispatch tables. Each table covers the function
+ * numbers [0, RT_SVC_FID_NUM_ENTRIES) of one owning entity, for both the
+ * SMC32 and SMC64 calling conventions. Function numbers outside this range are
+ * always dispatched through the service descriptor.
+ */
+#define RT_SVC_FID_NUM_ENTRIES_LOG2	6
+#define RT_SVC_FID_NUM_ENTRIES		(1 << RT_SVC_FID_NUM_ENTRIES_LOG2)
+#define RT_SVC_FID_TABLE_ENTRIES	(RT_SVC_FID_NUM_ENTRIES * 2)
+#define RT_SVC_FID_TABLES		2
+
 
 /*
  * In SMCCC 1.X, the function identifier has 6 bits for the owning entity number
@@ -143,6 +164,39 @@ CASSERT(RT_SVC_DESC_INIT == __builtin_offsetof(rt_svc_desc_t, init), \
 CASSERT(RT_SVC_DESC_HANDLE == __builtin_offsetof(rt_svc_desc_t, handle), \
 	assert_rt_svc_desc_handle_offset_mismatch);
 
+/*
+ * A runtime service function descriptor registers a leaf handler for the
+ * contiguous range of SMC Function IDs [start_fid, end_fid]. Both IDs must
+ * share the call type, calling convention and owning entity number, and the
+ * range must lie within the function numbers covered by a dispatch table.
+ *
+ * When an SMC matches a function descriptor, its handler is invoked directly,
+ * bypassing the handler of the service descriptor owning the OEN. The
+ * function descriptor is only used once the service descriptor owning the
+ * same OEN has been successfully initialised, and the service descriptor
+ * handler remains in charge of all the other function IDs.
+ */
+typedef struct rt_svc_fid_desc {
+	uint32_t start_fid;
+	uint32_t end_fid;
+	rt_svc_handle_t handle;
+} rt_svc_fid_desc_t;
+
+#define DECLARE_RT_SVC_FID(_name, _start_fid, _end_fid, _smch)		\
+	static const rt_svc_fid_desc_t __svc_fid_desc_ ## _name		\
+		__section("rt_svc_fid_descs") __used = {		\
+			.start_fid = _start_fid,			\
+			.end_fid = _end_fid,				\
+			.handle = _smch					\
+		}
+
+#ifndef AARCH32
+CASSERT((sizeof(rt_svc_fid_desc_t) == SIZEOF_RT_SVC_FID_DESC), \
+	assert_sizeof_rt_svc_fid_desc_mismatch);
+CASSERT(RT_SVC_FID_DESC_HANDLE == __builtin_offsetof(rt_svc_fid_desc_t, handle), \
+	assert_rt_svc_fid_desc_handle_offset_mismatch);
+#endif
+
 
 #if SMCCC_MAJOR_VERSION == 1
 /*
@@ -186,9 +240,19 @@ uintptr_t handle_runtime_svc(uint32_t smc_fid, void *cookie, void *handle,
 						unsigned int flags);
 IMPORT_SYM(uintptr_t, __RT_SVC_DESCS_START__,		RT_SVC_DESCS_START);
 IMPORT_SYM(uintptr_t, __RT_SVC_DESCS_END__,		RT_SVC_DESCS_END);
+IMPORT_SYM(uintptr_t, __RT_SVC_FID_DESCS_START__,	RT_SVC_FID_DESCS_START);
+IMPORT_SYM(uintptr_t, __RT_SVC_FID_DESCS_END__,	RT_SVC_FID_DESCS_END);
 void init_crash_reporting(void);
 
+#if ENABLE_SMC_STAT
+void runtime_svc_stat_count(uint32_t smc_fid);
+uint64_t runtime_svc_stat_get_count(uint32_t smc_fid);
+void runtime_svc_stat_print(void);
+#endif
+
 extern uint8_t rt_svc_descs_indices[MAX_RT_SVCS];
+extern uint8_t rt_svc_fid_tables_map[MAX_RT_SVCS];
+extern uint8_t rt_svc_fid_indices[RT_SVC_FID_TABLES][RT_SVC_FID_TABLE_ENTRIES];
 
 #endif /*__ASSEMBLY__*/
 #endif /* __RUNTIME_SVC_H__ */
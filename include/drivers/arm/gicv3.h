@@ -355,6 +355,15 @@ typedef struct gicv3_redist_ctx {
 	uint32_t gicr_icfgr1;
 	uint32_t gicr_igrpmodr0;
 	uint32_t gicr_nsacr;
+
+#if GICV3_TRACK_SECURE_CONFIG
+	/*
+	 * Generation of the Secure-only configuration last saved, 0 if none,
+	 * and Redistributor it was saved from.
+	 */
+	unsigned int gicr_secure_config_gen;
+	unsigned int gicr_secure_config_proc;
+#endif
 } gicv3_redist_ctx_t;
 
 typedef struct gicv3_dist_ctx {
@@ -371,6 +380,11 @@ typedef struct gicv3_dist_ctx {
 	uint32_t gicd_icfgr[GICD_NUM_REGS(ICFGR)];
 	uint32_t gicd_igrpmodr[GICD_NUM_REGS(IGRPMODR)];
 	uint32_t gicd_nsacr[GICD_NUM_REGS(NSACR)];
+
+#if GICV3_TRACK_SECURE_CONFIG
+	/* Generation of the Secure-only configuration last saved, 0 if none */
+	unsigned int gicd_secure_config_gen;
+#endif
 } gicv3_dist_ctx_t;
 
 typedef struct gicv3_its_ctx {
@@ -37,6 +37,11 @@ int auth_mod_get_parent_id(unsigned int img_id, unsigned int *parent_id);
 int auth_mod_verify_img(unsigned int img_id,
 			void *img_ptr,
 			unsigned int img_len);
+#if STREAM_IMAGE_HASH
+int auth_mod_hash_stream_start(unsigned int img_id, void *img_ptr);
+void auth_mod_hash_stream_update(void *data_ptr, unsigned int data_len);
+void auth_mod_hash_stream_finish(unsigned int img_len);
+#endif
 
 /* Macro to register a CoT defined as an array of auth_img_desc_t */
 #define REGISTER_COT(_cot) \
@@ -37,6 +37,23 @@ typedef struct crypto_lib_desc_s {
 	/* Verify a hash. Return one of the 'enum crypto_ret_value' options */
 	int (*verify_hash)(void *data_ptr, unsigned int data_len,
 			   void *digest_info_ptr, unsigned int digest_info_len);
+
+	/* Optional incremental hash verification. The hash of the data passed
+	 * to 'hash_stream_update' is compared with the digest info given to
+	 * 'hash_stream_start' when 'hash_stream_finish' is called. Only one
+	 * stream may be active at any time. Return one of the
+	 * 'enum crypto_ret_value' options */
+	int (*hash_stream_start)(void *digest_info_ptr,
+				 unsigned int digest_info_len);
+	int (*hash_stream_update)(void *data_ptr, unsigned int data_len);
+	int (*hash_stream_finish)(void);
+
+	/* Optional hash calculation. The hash algorithm is chosen by the library
+	 * and the size of the hash, which must not exceed '*hash_len', is
+	 * returned in '*hash_len'. Return one of the 'enum crypto_ret_value'
+	 * options */
+	int (*calc_hash)(void *data_ptr, unsigned int data_len,
+			 void *hash_ptr, unsigned int *hash_len);
 } crypto_lib_desc_t;
 
 /* Public functions */
@@ -47,6 +64,12 @@ int crypto_mod_verify_signature(void *data_ptr, unsigned int data_len,
 				void *pk_ptr, unsigned int pk_len);
 int crypto_mod_verify_hash(void *data_ptr, unsigned int data_len,
 			   void *digest_info_ptr, unsigned int digest_info_len);
+int crypto_mod_hash_stream_start(void *digest_info_ptr,
+				 unsigned int digest_info_len);
+int crypto_mod_hash_stream_update(void *data_ptr, unsigned int data_len);
+int crypto_mod_hash_stream_finish(void);
+int crypto_mod_calc_hash(void *data_ptr, unsigned int data_len,
+			 void *hash_ptr, unsigned int *hash_len);
 
 /* Macro to register a cryptographic library */
 #define REGISTER_CRYPTO_LIB(_name, _init, _verify_signature, _verify_hash) \
@@ -57,6 +80,25 @@ int crypto_mod_verify_hash(void *data_ptr, unsigned int data_len,
 		.verify_hash = _verify_hash \
 	}
 
+/*
+ * Macro to register a cryptographic library with incremental hash and hash
+ * calculation support
+ */
+#define REGISTER_CRYPTO_LIB_HASH_STREAM(_name, _init, _verify_signature, \
+					_verify_hash, _hash_stream_start, \
+					_hash_stream_update, \
+					_hash_stream_finish, _calc_hash) \
+	const crypto_lib_desc_t crypto_lib_desc = { \
+		.name = _name, \
+		.init = _init, \
+		.verify_signature = _verify_signature, \
+		.verify_hash = _verify_hash, \
+		.hash_stream_start = _hash_stream_start, \
+		.hash_stream_update = _hash_stream_update, \
+		.hash_stream_finish = _hash_stream_finish, \
+		.calc_hash = _calc_hash \
+	}
+
 extern const crypto_lib_desc_t crypto_lib_desc;
 
 #endif /* __CRYPTO_MOD_H__ */
@@ -79,6 +79,12 @@
 
 #define MBEDTLS_VERSION_C
 
+#if TF_MBEDTLS_USE_ARMV8_SHA
+/* The SHA compression functions are provided by mbedtls_sha_armv8.c */
+#define MBEDTLS_SHA256_PROCESS_ALT
+#define MBEDTLS_SHA512_PROCESS_ALT
+#endif
+
 #define MBEDTLS_X509_USE_C
 #define MBEDTLS_X509_CRT_PARSE_C
 
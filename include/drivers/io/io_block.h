@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2016, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2016-2018, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -15,10 +15,25 @@ typedef struct io_block_ops {
 	size_t	(*write)(int lba, const uintptr_t buf, size_t size);
 } io_block_ops_t;
 
+/*
+ * Flag to let the block driver pass the destination buffer of the caller to
+ * the read operation for the whole blocks of a transfer, instead of copying
+ * them from 'buffer'. Only set it if the low level driver can read any number
+ * of blocks at any address the images can be loaded to.
+ */
+#define IO_BLOCK_DIRECT_READ	(1U << 0)
+
 typedef struct io_block_dev_spec {
 	io_block_spec_t	buffer;
 	io_block_ops_t	ops;
 	size_t		block_size;
+	/*
+	 * Minimum number of bytes read into 'buffer' when a read goes through
+	 * it, so that the following sequential reads are served from memory.
+	 * It is limited by the size of 'buffer'. 0 only reads the blocks needed.
+	 */
+	size_t		read_ahead;
+	unsigned int	flags;
 } io_block_dev_spec_t;
 
 struct io_dev_connector;
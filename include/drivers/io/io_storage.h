@@ -99,4 +99,15 @@ int io_write(uintptr_t handle, const uintptr_t buffer, size_t length,
 int io_close(uintptr_t handle);
 
 
+/*
+ * Work done by the boot image while a storage driver waits for a transfer to
+ * complete. The handler returns 0 once it has nothing left to do.
+ */
+typedef int (*io_idle_handler_t)(void);
+
+void io_register_idle_handler(io_idle_handler_t handler);
+
+int io_idle(void);
+
+
 #endif /* __IO_H__ */
@@ -452,6 +452,7 @@
 #define TTBR1		p15, 0, c2, c0, 1
 #define TLBIALL		p15, 0, c8, c7, 0
 #define TLBIALLIS	p15, 0, c8, c3, 0
+#define TLBIALLHIS	p15, 4, c8, c3, 0
 #define TLBIMVA		p15, 0, c8, c7, 1
 #define TLBIMVAA	p15, 0, c8, c7, 3
 #define TLBIMVAAIS	p15, 0, c8, c3, 3
@@ -124,6 +124,17 @@
 #define ID_AA64PFR0_CSV2_MASK	ULL(0xf)
 #define ID_AA64PFR0_CSV2_LENGTH	U(4)
 
+/* ID_AA64ISAR0_EL1.SHA2 definitions */
+#define ID_AA64ISAR0_SHA2_SHIFT		U(12)
+#define ID_AA64ISAR0_SHA2_MASK		ULL(0xf)
+#define ID_AA64ISAR0_SHA2_SHA256	ULL(1)
+#define ID_AA64ISAR0_SHA2_SHA512	ULL(2)
+
+/* ID_AA64ISAR0_EL1.TLB definitions */
+#define ID_AA64ISAR0_TLB_SHIFT	U(56)
+#define ID_AA64ISAR0_TLB_MASK	ULL(0xf)
+#define ID_AA64ISAR0_TLB_RANGE	ULL(2)
+
 /* ID_AA64DFR0_EL1.PMS definitions (for ARMv8.2+) */
 #define ID_AA64DFR0_PMS_SHIFT	U(32)
 #define ID_AA64DFR0_PMS_LENGTH	U(4)
@@ -481,6 +492,13 @@
 
 #define MAX_CACHE_LINE_SIZE	U(0x800) /* 2KB */
 
+/*
+ * DCZID_EL0 definitions
+ */
+#define DCZID_BS_SHIFT		U(0)
+#define DCZID_BS_MASK		U(0xf)
+#define DCZID_DZP_BIT		U(4)
+
 /* Physical timer control register bit fields shifts and masks */
 #define CNTP_CTL_ENABLE_SHIFT   U(0)
 #define CNTP_CTL_IMASK_SHIFT    U(1)
@@ -555,6 +573,24 @@
 #define TLBI_ADDR_MASK		ULL(0x00000FFFFFFFFFFF)
 #define TLBI_ADDR(x)		(((x) >> TLBI_ADDR_SHIFT) & TLBI_ADDR_MASK)
 
+/*
+ * Operand of the TLBI range instructions (ARMv8.4-TLBI) for a 4KB granule.
+ * They invalidate (num + 1) * 2^(5 * scale + 1) pages starting from VA x.
+ */
+#define TLBI_RANGE_TG_4KB	ULL(1)
+#define TLBI_RANGE_TG_SHIFT	U(46)
+#define TLBI_RANGE_SCALE_SHIFT	U(44)
+#define TLBI_RANGE_NUM_SHIFT	U(39)
+#define TLBI_RANGE_NUM_MASK	ULL(0x1f)
+#define TLBI_RANGE_BADDR_MASK	ULL(0x1FFFFFFFFF)
+#define TLBI_RANGE_ADDR(x, scale, num)					\
+	((TLBI_RANGE_TG_4KB << TLBI_RANGE_TG_SHIFT) |			\
+	 ((unsigned long long)(scale) << TLBI_RANGE_SCALE_SHIFT) |	\
+	 ((unsigned long long)(num) << TLBI_RANGE_NUM_SHIFT) |		\
+	 (((x) >> TLBI_ADDR_SHIFT) & TLBI_RANGE_BADDR_MASK))
+#define TLBI_RANGE_PAGES(scale, num)					\
+	(((unsigned long long)(num) + 1ULL) << ((5U * (scale)) + 1U))
+
 /*******************************************************************************
  * Definitions of register offsets and fields in the CNTCTLBase Frame of the
  * system level implementation of the Generic Timer.
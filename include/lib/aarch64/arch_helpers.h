@@ -123,6 +123,7 @@ DEFINE_SYSOP_TYPE_FUNC(tlbi, alle3)
 DEFINE_SYSOP_TYPE_FUNC(tlbi, alle3is)
 #endif
 DEFINE_SYSOP_TYPE_FUNC(tlbi, vmalle1)
+DEFINE_SYSOP_TYPE_FUNC(tlbi, vmalle1is)
 
 DEFINE_SYSOP_TYPE_PARAM_FUNC(tlbi, vaae1is)
 DEFINE_SYSOP_TYPE_PARAM_FUNC(tlbi, vaale1is)
@@ -136,6 +137,22 @@ DEFINE_SYSOP_TYPE_PARAM_FUNC(tlbi, vae3is)
 DEFINE_SYSOP_TYPE_PARAM_FUNC(tlbi, vale3is)
 #endif
 
+/*
+ * The TLBI range instructions of ARMv8.4-TLBI are written with their system
+ * instruction encoding so that they can be built for any architecture
+ * version. They must only be executed if ID_AA64ISAR0_EL1.TLB reports them.
+ */
+#define DEFINE_TLBIOP_RANGE_FUNC(_type, _op1, _crm, _op2)		\
+static inline void tlbi ## _type(uint64_t v)				\
+{									\
+	__asm__ ("sys #" #_op1 ", c8, " #_crm ", #" #_op2 ", %0"	\
+		 : : "r" (v));						\
+}
+
+DEFINE_TLBIOP_RANGE_FUNC(rvaae1is, 0, c2, 3)
+DEFINE_TLBIOP_RANGE_FUNC(rvae2is, 4, c2, 1)
+DEFINE_TLBIOP_RANGE_FUNC(rvae3is, 6, c2, 1)
+
 /*******************************************************************************
  * Cache maintenance accessor prototypes
  ******************************************************************************/
@@ -182,6 +199,7 @@ DEFINE_SYSREG_READ_FUNC(par_el1)
 DEFINE_SYSREG_READ_FUNC(id_pfr1_el1)
 DEFINE_SYSREG_READ_FUNC(id_aa64pfr0_el1)
 DEFINE_SYSREG_READ_FUNC(id_aa64dfr0_el1)
+DEFINE_SYSREG_READ_FUNC(id_aa64isar0_el1)
 DEFINE_SYSREG_READ_FUNC(CurrentEl)
 DEFINE_SYSREG_RW_FUNCS(daif)
 DEFINE_SYSREG_RW_FUNCS(spsr_el1)
@@ -32,7 +32,50 @@
 /*****************************************************************************
  * External bakery lock interface.
  ****************************************************************************/
-#if USE_COHERENT_MEM
+#if USE_QUEUED_BAKERY_LOCK
+/*
+ * Bakery locks are queued locks stored in normal .bss memory
+ *
+ * The CPUs are split in groups, normally one per cluster, that each queue on
+ * a ticket lock of their own. The CPU at the head of a group queue then takes
+ * a ticket on the global queue, unless the global lock was handed over to it
+ * by the previous owner from the same group. Each queue lives in its own cache
+ * line so that CPUs only spin on lines shared within their group.
+ */
+#ifndef PLAT_BAKERY_LOCK_QUEUE_CPUS
+# ifdef PLATFORM_MAX_CPUS_PER_CLUSTER
+#  define PLAT_BAKERY_LOCK_QUEUE_CPUS	PLATFORM_MAX_CPUS_PER_CLUSTER
+# else
+#  define PLAT_BAKERY_LOCK_QUEUE_CPUS	PLATFORM_CORE_COUNT
+# endif
+#endif
+
+#define BAKERY_LOCK_QUEUE_COUNT	\
+	((BAKERY_LOCK_MAX_CPUS + PLAT_BAKERY_LOCK_QUEUE_CPUS - 1) / \
+	 PLAT_BAKERY_LOCK_QUEUE_CPUS)
+
+typedef struct bakery_queue {
+	/* Next ticket to be handed out */
+	volatile uint32_t next;
+	/* Ticket currently being served */
+	volatile uint32_t owner;
+	/*
+	 * Only accessed by the owner of a group queue: whether the global lock
+	 * was handed over within the group, and how many times in a row.
+	 */
+	uint32_t global_held;
+	uint32_t handovers;
+} __aligned(CACHE_WRITEBACK_GRANULE) bakery_queue_t;
+
+typedef struct bakery_lock {
+	bakery_queue_t global;
+	bakery_queue_t group[BAKERY_LOCK_QUEUE_COUNT];
+} bakery_lock_t;
+
+/* Atomically increment '*ticket' and return its previous value */
+uint32_t bakery_take_ticket(volatile uint32_t *ticket);
+
+#elif USE_COHERENT_MEM
 /*
  * Bakery locks are stored in coherent memory
  *
@@ -77,7 +120,11 @@ static inline void bakery_lock_init(bakery_lock_t *bakery) {}
 void bakery_lock_get(bakery_lock_t *bakery);
 void bakery_lock_release(bakery_lock_t *bakery);
 
+#if USE_QUEUED_BAKERY_LOCK
+#define DEFINE_BAKERY_LOCK(_name) bakery_lock_t _name
+#else
 #define DEFINE_BAKERY_LOCK(_name) bakery_lock_t _name __section("bakery_lock")
+#endif
 
 #define DECLARE_BAKERY_LOCK(_name) extern bakery_lock_t _name
 
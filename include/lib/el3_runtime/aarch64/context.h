@@ -59,7 +59,12 @@
 #define CTX_RUNTIME_SP		U(0x10)
 #define CTX_SPSR_EL3		U(0x18)
 #define CTX_ELR_EL3		U(0x20)
+#if CTX_LAZY_FPREGS
+/* Non-zero when the FP registers hold the state of this context */
+#define CTX_FPREGS_LIVE		U(0x28)
+#else
 #define CTX_UNUSED		U(0x28)
+#endif
 #define CTX_EL3STATE_END	U(0x30)
 
 /*******************************************************************************
@@ -124,6 +129,21 @@
 #define CTX_SYSREGS_END		CTX_TIMER_SYSREGS_OFF
 #endif /* __NS_TIMER_SWITCH__ */
 
+/*
+ * Groups of EL1 system registers that can be saved and restored separately.
+ * A world switch may leave out the groups that the Secure payload does not
+ * modify, as the Non-secure values then stay in the registers.
+ */
+#define CTX_EL1_SYSREGS_CORE_SHIFT	U(0)
+#define CTX_EL1_SYSREGS_AARCH32_SHIFT	U(1)
+#define CTX_EL1_SYSREGS_TIMER_SHIFT	U(2)
+#define CTX_EL1_SYSREGS_CORE		(U(1) << CTX_EL1_SYSREGS_CORE_SHIFT)
+#define CTX_EL1_SYSREGS_AARCH32		(U(1) << CTX_EL1_SYSREGS_AARCH32_SHIFT)
+#define CTX_EL1_SYSREGS_TIMER		(U(1) << CTX_EL1_SYSREGS_TIMER_SHIFT)
+#define CTX_EL1_SYSREGS_ALL		(CTX_EL1_SYSREGS_CORE | \
+					 CTX_EL1_SYSREGS_AARCH32 | \
+					 CTX_EL1_SYSREGS_TIMER)
+
 /*******************************************************************************
  * Constants that allow assembler code to access members of and the 'fp_regs'
  * structure at their correct offsets.
@@ -330,8 +350,8 @@ CASSERT(CTX_CVE_2018_3639_OFFSET == __builtin_offsetof(cpu_context_t, cve_2018_3
 /*******************************************************************************
  * Function prototypes
  ******************************************************************************/
-void el1_sysregs_context_save(el1_sys_regs_t *regs);
-void el1_sysregs_context_restore(el1_sys_regs_t *regs);
+void el1_sysregs_context_save(el1_sys_regs_t *regs, unsigned int mask);
+void el1_sysregs_context_restore(el1_sys_regs_t *regs, unsigned int mask);
 #if CTX_INCLUDE_FPREGS
 void fpregs_context_save(fp_regs_t *regs);
 void fpregs_context_restore(fp_regs_t *regs);
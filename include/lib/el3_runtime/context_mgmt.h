@@ -36,8 +36,13 @@ void cm_setup_context(cpu_context_t *ctx, const entry_point_info_t *ep);
 void cm_prepare_el3_exit(uint32_t security_state);
 
 #ifndef AARCH32
+void cm_set_el1_sysregs_mask(unsigned int mask);
 void cm_el1_sysregs_context_save(uint32_t security_state);
 void cm_el1_sysregs_context_restore(uint32_t security_state);
+void cm_el1_sysregs_context_save_mask(uint32_t security_state,
+				      unsigned int mask);
+void cm_el1_sysregs_context_restore_mask(uint32_t security_state,
+					 unsigned int mask);
 void cm_set_elr_el3(uint32_t security_state, uintptr_t entrypoint);
 void cm_set_elr_spsr_el3(uint32_t security_state,
 			uintptr_t entrypoint, uint32_t spsr);
@@ -46,6 +51,10 @@ void cm_write_scr_el3_bit(uint32_t security_state,
 			  uint32_t value);
 void cm_set_next_eret_context(uint32_t security_state);
 uint32_t cm_get_scr_el3(uint32_t security_state);
+#if CTX_LAZY_FPREGS
+void cm_fpregs_lazy_save(void);
+void cm_fpregs_lazy_switch(cpu_context_t *ctx);
+#endif
 
 
 void cm_init_context(uint64_t mpidr,
@@ -0,0 +1,21 @@
+/*
+ * Copyright (c) 2018, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef __LZ4_DECOMPRESS_H__
+#define __LZ4_DECOMPRESS_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+int lz4_decompress(uintptr_t *in_buf, size_t in_len, uintptr_t *out_buf,
+		   size_t out_len, uintptr_t work_buf, size_t work_len);
+
+int lz4_stream_start(uintptr_t out_buf, size_t out_len,
+		     uintptr_t work_buf, size_t work_len);
+int lz4_stream_update(uintptr_t in_buf, size_t in_len);
+int lz4_stream_finish(uintptr_t *out_buf);
+
+#endif /* __LZ4_DECOMPRESS_H__ */
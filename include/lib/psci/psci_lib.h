@@ -84,6 +84,11 @@ u_register_t psci_smc_handler(uint32_t smc_fid,
 			  u_register_t flags);
 int psci_setup(const psci_lib_args_t *lib_args);
 int psci_secondaries_brought_up(void);
+int psci_cpu_on_batch(u_register_t target_base,
+		      u_register_t target_map,
+		      uintptr_t entrypoint,
+		      u_register_t context_id,
+		      u_register_t *on_map);
 void psci_warmboot_entrypoint(void);
 void psci_register_spd_pm_hook(const spd_pm_ops_t *pm);
 void psci_prepare_next_non_secure_ctx(
@@ -13,7 +13,20 @@
 #define RT_INSTR_EXIT_HW_LOW_PWR	3
 #define RT_INSTR_ENTER_CFLUSH		4
 #define RT_INSTR_EXIT_CFLUSH		5
-#define RT_INSTR_TOTAL_IDS		6
+
+/*
+ * Time-stamps of a Normal world call handled by a Secure Payload, in the order
+ * in which they are recorded. RT_INSTR_ENTER_SP and RT_INSTR_EXIT_SP are only
+ * recorded for the TSP null service, which reports them in its results.
+ */
+#define RT_INSTR_ENTER_SPD		6
+#define RT_INSTR_ENTER_SPD_SWITCH	7
+#define RT_INSTR_EXIT_SPD_SWITCH	8
+#define RT_INSTR_ENTER_SP		9
+#define RT_INSTR_EXIT_SP		10
+#define RT_INSTR_ENTER_SPD_RETURN	11
+#define RT_INSTR_EXIT_SPD		12
+#define RT_INSTR_TOTAL_IDS		13
 
 #ifndef __ASSEMBLY__
 PMF_DECLARE_CAPTURE_TIMESTAMP(rt_instr_svc)
@@ -0,0 +1,47 @@
+/*
+ * Copyright (c) 2018, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef __SMC_LATENCY_HIST_H__
+#define __SMC_LATENCY_HIST_H__
+
+/*
+ * The SMC latency histograms are read through the PMF service
+ * PMF_SMC_LATENCY_SVC_ID. The time-stamp id passed to PMF_SMC_GET_TIMESTAMP
+ * selects a histogram slot of the target CPU in bits [23:16] and one of the
+ * fields below in bits [7:0]. Durations are measured in system counter ticks,
+ * from the exception entry into EL3 until the SMC handler returns.
+ */
+#define SMC_HIST_SLOT_SHIFT		16
+#define SMC_HIST_SLOT_MASK		(0xFF << SMC_HIST_SLOT_SHIFT)
+
+/*
+ * Number of histogram slots per CPU. A slot is assigned to each SMC function
+ * ID the first time it is called on a CPU. The last slot accounts for all the
+ * SMCs that could not be given a slot of their own.
+ */
+#define SMC_HIST_SLOTS			16
+#define SMC_HIST_SLOT_OTHER		(SMC_HIST_SLOTS - 1)
+#define SMC_HIST_FID_OTHER		0xFFFFFFFFU
+
+/* Number of log2 buckets: bucket n counts durations in [2^(n-1), 2^n) */
+#define SMC_HIST_BUCKETS		32
+
+/* Fields of a histogram slot */
+#define SMC_HIST_FID			0	/* SMC function ID */
+#define SMC_HIST_COUNT			1	/* Number of calls */
+#define SMC_HIST_SUM			2	/* Sum of the durations */
+#define SMC_HIST_MAX			3	/* Longest duration */
+#define SMC_HIST_RESET			4	/* Clears the CPU histograms */
+#define SMC_HIST_BUCKET(_n)		(8 + (_n))
+#define SMC_HIST_TOTAL_IDS		SMC_HIST_BUCKET(SMC_HIST_BUCKETS)
+
+#ifndef __ASSEMBLY__
+#include <stdint.h>
+
+void smc_latency_hist_record(uint32_t smc_fid);
+#endif /* __ASSEMBLY__ */
+
+#endif /* __SMC_LATENCY_HIST_H__ */
@@ -74,6 +74,11 @@ struct xlat_ctx {
 	 */
 #if PLAT_XLAT_TABLES_DYNAMIC
 	int *tables_mapped_regions;
+	/*
+	 * First table of the list of tables that have no region mapped. The
+	 * list is linked through the first entry of each table.
+	 */
+	uint64_t *next_empty_table;
 #endif /* PLAT_XLAT_TABLES_DYNAMIC */
 
 	int next_table;
@@ -111,7 +116,8 @@ struct xlat_ctx {
 	static int _ctx_name##_mapped_regions[_xlat_tables_count];
 
 #define XLAT_REGISTER_DYNMAP_STRUCT(_ctx_name)				\
-	.tables_mapped_regions = _ctx_name##_mapped_regions,
+	.tables_mapped_regions = _ctx_name##_mapped_regions,		\
+	.next_empty_table = NULL,
 #else
 #define XLAT_ALLOC_DYNMAP_STRUCT(_ctx_name, _xlat_tables_count)		\
 	/* do nothing */
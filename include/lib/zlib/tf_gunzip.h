@@ -13,4 +13,9 @@
 int gunzip(uintptr_t *in_buf, size_t in_len, uintptr_t *out_buf,
 	   size_t out_len, uintptr_t work_buf, size_t work_len);
 
+int gunzip_stream_start(uintptr_t out_buf, size_t out_len,
+			uintptr_t work_buf, size_t work_len);
+int gunzip_stream_update(uintptr_t in_buf, size_t in_len);
+int gunzip_stream_finish(uintptr_t *out_buf);
+
 #endif /* __TF_GUNZIP_H___ */
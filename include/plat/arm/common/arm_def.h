@@ -361,6 +361,21 @@
 #define ARM_TB_FW_CONFIG_BASE		ARM_BL_RAM_BASE + sizeof(meminfo_t)
 #define ARM_TB_FW_CONFIG_LIMIT		ARM_BL_RAM_BASE + PAGE_SIZE
 
+/*
+ * If AUTH_CERT_CACHE is enabled, the certificates verified by BL1 are handed
+ * over to BL2 at the end of the same page.
+ */
+#if AUTH_CERT_CACHE
+#define PLAT_AUTH_CERT_CACHE_SIZE	U(0x400)
+#define PLAT_AUTH_CERT_CACHE_BASE	((ARM_TB_FW_CONFIG_LIMIT) -	\
+					 PLAT_AUTH_CERT_CACHE_SIZE)
+#define ARM_TB_FW_CONFIG_MAX_SIZE	(PLAT_AUTH_CERT_CACHE_BASE -	\
+					 (ARM_TB_FW_CONFIG_BASE))
+#else
+#define ARM_TB_FW_CONFIG_MAX_SIZE	((ARM_TB_FW_CONFIG_LIMIT) -	\
+					 (ARM_TB_FW_CONFIG_BASE))
+#endif
+
 /*******************************************************************************
  * BL1 specific defines.
  * BL1 RW data is relocated from ROM to RAM at runtime so we need 2 sets of
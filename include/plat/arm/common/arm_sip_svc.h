@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2016-2017, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2016-2018, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -17,8 +17,14 @@
 /* Function ID for requesting state switch of lower EL */
 #define ARM_SIP_SVC_EXE_STATE_SWITCH	0x82000020
 
+/* Function ID for turning on several CPUs with a single call */
+#define ARM_SIP_SVC_CPU_ON_BATCH	0xc2000021
+
+/* Function ID for reading the call count of an SMC (ENABLE_SMC_STAT=1) */
+#define ARM_SIP_SVC_SMC_COUNT		0xc2000022
+
 /* ARM SiP Service Calls version numbers */
 #define ARM_SIP_SVC_VERSION_MAJOR		0x0
-#define ARM_SIP_SVC_VERSION_MINOR		0x2
+#define ARM_SIP_SVC_VERSION_MINOR		0x4
 
 #endif /* __ARM_SIP_SVC_H__ */
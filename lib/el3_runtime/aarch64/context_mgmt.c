@@ -22,6 +22,8 @@
 #include <sve.h>
 #include <utils.h>
 
+/* Groups of EL1 system registers switched between the worlds */
+static unsigned int el1_sysregs_mask = CTX_EL1_SYSREGS_ALL;
 
 /*******************************************************************************
  * Context management library initialisation routine. This library is used by
@@ -447,23 +449,53 @@ void cm_prepare_el3_exit(uint32_t security_state)
 		enable_extensions_nonsecure(el2_unused);
 	}
 
-	cm_el1_sysregs_context_restore(security_state);
+	/* Initialise all the EL1 system registers on the first entry */
+	cm_el1_sysregs_context_restore_mask(security_state,
+					    CTX_EL1_SYSREGS_ALL);
 	cm_set_next_eret_context(security_state);
 }
 
+/*******************************************************************************
+ * This function sets the groups of EL1 system registers, among the
+ * CTX_EL1_SYSREGS_* ones, that cm_el1_sysregs_context_save() and
+ * cm_el1_sysregs_context_restore() switch between the worlds. A Secure Payload
+ * Dispatcher calls it during its setup to leave out the groups that its Secure
+ * payload does not modify: these registers then keep their Non-secure values.
+ ******************************************************************************/
+void cm_set_el1_sysregs_mask(unsigned int mask)
+{
+	assert((mask & CTX_EL1_SYSREGS_CORE) != 0U);
+	assert((mask & ~CTX_EL1_SYSREGS_ALL) == 0U);
+
+	el1_sysregs_mask = mask;
+}
+
 /*******************************************************************************
  * The next four functions are used by runtime services to save and restore
  * EL1 context on the 'cpu_context' structure for the specified security
- * state.
+ * state. The '_mask' variants only save or restore the CTX_EL1_SYSREGS_* groups
+ * in 'mask', e.g. none of them when the caller knows that the saved context is
+ * still valid.
  ******************************************************************************/
 void cm_el1_sysregs_context_save(uint32_t security_state)
+{
+	cm_el1_sysregs_context_save_mask(security_state, el1_sysregs_mask);
+}
+
+void cm_el1_sysregs_context_restore(uint32_t security_state)
+{
+	cm_el1_sysregs_context_restore_mask(security_state, el1_sysregs_mask);
+}
+
+void cm_el1_sysregs_context_save_mask(uint32_t security_state,
+				      unsigned int mask)
 {
 	cpu_context_t *ctx;
 
 	ctx = cm_get_context(security_state);
 	assert(ctx);
 
-	el1_sysregs_context_save(get_sysregs_ctx(ctx));
+	el1_sysregs_context_save(get_sysregs_ctx(ctx), mask);
 
 #if IMAGE_BL31
 	if (security_state == SECURE)
@@ -473,14 +505,15 @@ void cm_el1_sysregs_context_save(uint32_t security_state)
 #endif
 }
 
-void cm_el1_sysregs_context_restore(uint32_t security_state)
+void cm_el1_sysregs_context_restore_mask(uint32_t security_state,
+					 unsigned int mask)
 {
 	cpu_context_t *ctx;
 
 	ctx = cm_get_context(security_state);
 	assert(ctx);
 
-	el1_sysregs_context_restore(get_sysregs_ctx(ctx));
+	el1_sysregs_context_restore(get_sysregs_ctx(ctx), mask);
 
 #if IMAGE_BL31
 	if (security_state == SECURE)
@@ -490,6 +523,57 @@ void cm_el1_sysregs_context_restore(uint32_t security_state)
 #endif
 }
 
+#if CTX_LAZY_FPREGS
+/*******************************************************************************
+ * With CTX_LAZY_FPREGS, the FP registers are only switched when a lower EL
+ * accesses them. The context whose state they hold has CTX_FPREGS_LIVE set, and
+ * the copy in its 'fp_regs' structure is stale. el3_exit() traps the FP accesses
+ * of the other contexts through CPTR_EL3.TFP.
+ ******************************************************************************/
+static void fpregs_save_live(cpu_context_t *ctx)
+{
+	el3_state_t *state;
+
+	if (ctx == NULL)
+		return;
+
+	state = get_el3state_ctx(ctx);
+	if (read_ctx_reg(state, CTX_FPREGS_LIVE) != 0U) {
+		fpregs_context_save(get_fpregs_ctx(ctx));
+		write_ctx_reg(state, CTX_FPREGS_LIVE, 0U);
+	}
+}
+
+/*******************************************************************************
+ * This function saves the FP registers to the context of this CPU whose state
+ * they hold, if any. It must be called before the FP registers are lost, e.g.
+ * when the CPU is powered down.
+ ******************************************************************************/
+void cm_fpregs_lazy_save(void)
+{
+	/* The FP registers may be trapped by the last el3_exit() */
+	write_cptr_el3(read_cptr_el3() & ~TFP_BIT);
+	isb();
+
+	fpregs_save_live(cm_get_context(SECURE));
+	fpregs_save_live(cm_get_context(NON_SECURE));
+}
+
+/*******************************************************************************
+ * This function is called when the lower EL of the context 'ctx' has accessed
+ * the trapped FP registers. It hands the FP registers over to 'ctx' so that the
+ * access does not trap any more.
+ ******************************************************************************/
+void cm_fpregs_lazy_switch(cpu_context_t *ctx)
+{
+	assert(ctx);
+
+	cm_fpregs_lazy_save();
+	fpregs_context_restore(get_fpregs_ctx(ctx));
+	write_ctx_reg(get_el3state_ctx(ctx), CTX_FPREGS_LIVE, 1U);
+}
+#endif /* CTX_LAZY_FPREGS */
+
 /*******************************************************************************
  * This function populates ELR_EL3 member of 'cpu_context' pertaining to the
  * given security state with the given entrypoint
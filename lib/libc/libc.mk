@@ -10,9 +10,7 @@ LIBC_SRCS	:=	$(addprefix lib/libc/,	\
 			exit.c				\
 			memchr.c			\
 			memcmp.c			\
-			memcpy.c			\
 			memmove.c			\
-			memset.c			\
 			printf.c			\
 			putchar.c			\
 			puts.c				\
@@ -23,5 +21,9 @@ LIBC_SRCS	:=	$(addprefix lib/libc/,	\
 			strncmp.c			\
 			strnlen.c)
 
+LIBC_SRCS	+=	$(addprefix lib/libc/$(ARCH)/,	\
+			memcpy.S			\
+			memset.S)
+
 INCLUDES	+=	-Iinclude/lib/libc		\
 			-Iinclude/lib/libc/$(ARCH)	\
@@ -5,6 +5,12 @@
  */
 
 #include <stddef.h>
+#include <stdint.h>
+
+/* Machine word type that may alias any other object */
+typedef unsigned long __attribute__((__may_alias__)) word_t;
+
+#define WORD_MASK	(sizeof(word_t) - 1U)
 
 int memcmp(const void *s1, const void *s2, size_t len)
 {
@@ -13,6 +19,27 @@ int memcmp(const void *s1, const void *s2, size_t len)
 	unsigned char sc;
 	unsigned char dc;
 
+	/*
+	 * When both buffers share the same word alignment, skip over equal
+	 * words and only compare bytes in the first word that differs.
+	 */
+	if ((((uintptr_t)s ^ (uintptr_t)d) & WORD_MASK) == 0U) {
+		while ((len != 0U) && (((uintptr_t)s & WORD_MASK) != 0U)) {
+			sc = *s++;
+			dc = *d++;
+			if (sc - dc)
+				return (sc - dc);
+			len--;
+		}
+
+		while ((len >= sizeof(word_t)) &&
+		       (*(const word_t *)s == *(const word_t *)d)) {
+			s += sizeof(word_t);
+			d += sizeof(word_t);
+			len -= sizeof(word_t);
+		}
+	}
+
 	while (len--) {
 		sc = *s++;
 		dc = *d++;
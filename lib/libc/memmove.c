@@ -4,8 +4,14 @@
  * SPDX-License-Identifier: BSD-3-Clause
  */
 
+#include <stdint.h>
 #include <string.h>
 
+/* Machine word type that may alias any other object */
+typedef unsigned long __attribute__((__may_alias__)) word_t;
+
+#define WORD_MASK	(sizeof(word_t) - 1U)
+
 void *memmove(void *dst, const void *src, size_t len)
 {
 	/*
@@ -24,6 +30,24 @@ void *memmove(void *dst, const void *src, size_t len)
 		const char *end = dst;
 		const char *s = (const char *)src + len;
 		char *d = (char *)dst + len;
+
+		/*
+		 * When both areas share the same word alignment, align the end
+		 * pointers and copy whole words. As dst > src here, the two
+		 * pointers are then at least one word apart, so a single word
+		 * access never reads bytes it has already written.
+		 */
+		if ((((uintptr_t)d ^ (uintptr_t)s) & WORD_MASK) == 0U) {
+			while ((d != end) && (((uintptr_t)d & WORD_MASK) != 0U))
+				*--d = *--s;
+
+			while ((size_t)(d - end) >= sizeof(word_t)) {
+				d -= sizeof(word_t);
+				s -= sizeof(word_t);
+				*(word_t *)d = *(const word_t *)s;
+			}
+		}
+
 		while (d != end)
 			*--d = *--s;
 	}
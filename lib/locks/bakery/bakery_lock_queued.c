@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2018, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <arch_helpers.h>
+#include <assert.h>
+#include <bakery_lock.h>
+#include <platform.h>
+
+/*
+ * Functions in this file implement the bakery lock interface with queued
+ * ticket locks, for systems where all the contenders are cache-coherent and
+ * can use exclusive accesses on the lock data.
+ *
+ * Lamport's Bakery algorithm makes every contender scan the state of all the
+ * CPUs. Here, a contender takes a ticket on the queue of its group of CPUs,
+ * normally its cluster, and waits for its turn by polling the cache line of
+ * that queue only. The CPU at the head of the group queue then competes for
+ * the global queue on behalf of its group. When the lock is released while
+ * other CPUs of the same group are queued, the global lock is handed over to
+ * the next of them instead of being released, so the lock data stays within
+ * the cluster. The number of consecutive handovers is bounded so that other
+ * groups are served fairly.
+ */
+
+/* Maximum number of consecutive handovers of the global lock within a group */
+#define BAKERY_LOCK_MAX_HANDOVERS	8U
+
+#define assert_bakery_entry_valid(_entry, _bakery) do {	\
+	assert(_bakery);					\
+	assert(_entry < BAKERY_LOCK_MAX_CPUS);		\
+} while (0)
+
+/* Wait for 'ticket' to be served by 'queue' */
+static void bakery_queue_wait(const bakery_queue_t *queue, uint32_t ticket)
+{
+	while (queue->owner != ticket)
+		wfe();
+
+	/*
+	 * Ensure that any reads from the lock or from a shared resource in the
+	 * critical section read values after the ticket is served.
+	 */
+	dmbld();
+}
+
+/* Serve the next ticket of 'queue' and signal waiting contenders */
+static void bakery_queue_advance(bakery_queue_t *queue)
+{
+	/*
+	 * Ensure that other observers see any stores in the critical section
+	 * before the next ticket is served.
+	 */
+	dmbish();
+	queue->owner = queue->owner + 1U;
+	dsb();
+	sev();
+}
+
+/*
+ * Acquire bakery lock
+ *
+ * The contending CPU first queues on its group, then, unless the global lock
+ * was handed over to its group, queues on the global lock.
+ */
+void bakery_lock_get(bakery_lock_t *bakery)
+{
+	unsigned int me = plat_my_core_pos();
+	bakery_queue_t *group;
+
+	assert_bakery_entry_valid(me, bakery);
+
+	group = &bakery->group[me / PLAT_BAKERY_LOCK_QUEUE_CPUS];
+	bakery_queue_wait(group, bakery_take_ticket(&group->next));
+
+	if (group->global_held == 0U) {
+		bakery_queue_wait(&bakery->global,
+				  bakery_take_ticket(&bakery->global.next));
+	}
+}
+
+/* Release the lock and signal contenders */
+void bakery_lock_release(bakery_lock_t *bakery)
+{
+	unsigned int me = plat_my_core_pos();
+	bakery_queue_t *group;
+
+	assert_bakery_entry_valid(me, bakery);
+
+	group = &bakery->group[me / PLAT_BAKERY_LOCK_QUEUE_CPUS];
+	assert(group->next != group->owner);
+
+	/*
+	 * Hand the global lock over if another CPU of the group has taken a
+	 * ticket. It is then bound to be the next owner of the group queue.
+	 */
+	if (((group->next - group->owner) > 1U) &&
+	    (group->handovers < BAKERY_LOCK_MAX_HANDOVERS)) {
+		group->global_held = 1U;
+		group->handovers++;
+	} else {
+		group->global_held = 0U;
+		group->handovers = 0U;
+		bakery_queue_advance(&bakery->global);
+	}
+
+	bakery_queue_advance(group);
+}
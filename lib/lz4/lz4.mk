@@ -0,0 +1,12 @@
+#
+# Copyright (c) 2018, ARM Limited and Contributors. All rights reserved.
+#
+# SPDX-License-Identifier: BSD-3-Clause
+#
+
+LZ4_PATH	:=	lib/lz4
+
+LZ4_SOURCES	:=	$(addprefix $(LZ4_PATH)/,	\
+					lz4_decompress.c)
+
+INCLUDES	+=	-Iinclude/lib/lz4
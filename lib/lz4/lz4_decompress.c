@@ -0,0 +1,576 @@
+/*
+ * Copyright (c) 2018, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <debug.h>
+#include <errno.h>
+#include <lz4_decompress.h>
+#include <string.h>
+#include <utils_def.h>
+
+/*
+ * Decompressor for the LZ4 frame format, as generated by "fiptool compress" or
+ * by the lz4 command line tool. LZ4 trades compression ratio for speed: a block
+ * is a sequence of literal runs and matches with byte-aligned lengths and
+ * offsets, so decoding it mostly consists of memory copies.
+ *
+ * Blocks are decoded straight from the input when they are entirely available.
+ * A block split across two chunks of input is first gathered into the work
+ * buffer, which must then be as large as the maximum block size of the frame.
+ * The header, block and content checksums are verified. Frames using a preset
+ * dictionary are not supported.
+ */
+
+#define LZ4_FRAME_MAGIC			0x184D2204U
+
+#define LZ4_FLG_VERSION_MASK		0xC0U
+#define LZ4_FLG_VERSION			0x40U
+#define LZ4_FLG_BLOCK_CHECKSUM		0x10U
+#define LZ4_FLG_CONTENT_SIZE		0x08U
+#define LZ4_FLG_CONTENT_CHECKSUM	0x04U
+#define LZ4_FLG_RESERVED		0x02U
+#define LZ4_FLG_DICT_ID			0x01U
+
+#define LZ4_BD_MAX_SIZE_SHIFT		4
+#define LZ4_BD_MAX_SIZE_MASK		0x7U
+#define LZ4_BD_RESERVED			0x8FU
+
+/* Magic number, FLG and BD bytes */
+#define LZ4_HEADER_START_LEN		6U
+/* Header with a content size, but no dictionary ID */
+#define LZ4_HEADER_MAX_LEN		15U
+
+#define LZ4_BLOCK_UNCOMPRESSED		0x80000000U
+#define LZ4_MIN_MATCH			4U
+
+/* Literal runs and matches shorter than this are copied byte per byte */
+#define LZ4_MIN_MEMCPY			16U
+
+#define XXH_PRIME32_1			0x9E3779B1U
+#define XXH_PRIME32_2			0x85EBCA77U
+#define XXH_PRIME32_3			0xC2B2AE3DU
+#define XXH_PRIME32_4			0x27D4EB2FU
+#define XXH_PRIME32_5			0x165667B1U
+
+#define ROTL32(x, n)	(((x) << (n)) | ((x) >> (32U - (n))))
+
+typedef uint32_t __attribute__((__may_alias__)) lz4_word_t;
+
+typedef enum {
+	LZ4_STATE_HEADER,
+	LZ4_STATE_BLOCK_SIZE,
+	LZ4_STATE_BLOCK,
+	LZ4_STATE_CONTENT_CHECKSUM,
+	LZ4_STATE_END
+} lz4_state_t;
+
+/*
+ * State of the decompression started by lz4_stream_start(). ret is a negative
+ * error code once the decompression has failed. The header, block sizes and
+ * checksums are gathered into 'field', the blocks that are split across chunks
+ * of input into the work buffer. 'need' is the length of the item being
+ * gathered and 'have' the number of its bytes gathered so far.
+ */
+static struct {
+	lz4_state_t state;
+	int ret;
+	uint8_t *out_start;
+	uint8_t *out;
+	uint8_t *out_end;
+	uint8_t *work;
+	size_t work_len;
+	uint8_t flags;
+	size_t block_max;
+	uint64_t content_size;
+	uint8_t field[LZ4_HEADER_MAX_LEN];
+	size_t need;
+	size_t have;
+	size_t total_in;
+} lz4_stream;
+
+static inline uint32_t read_le32(const uint8_t *p)
+{
+	return (uint32_t)p[0] | ((uint32_t)p[1] << 8) |
+	       ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+/* Load a little-endian word, with an aligned access if possible */
+static inline uint32_t load_le32(const uint8_t *p)
+{
+	if (((uintptr_t)p & 3U) == 0U)
+		return *(const lz4_word_t *)(const void *)p;
+
+	return read_le32(p);
+}
+
+static inline uint32_t xxh32_round(uint32_t acc, uint32_t input)
+{
+	acc += input * XXH_PRIME32_2;
+	acc = ROTL32(acc, 13U);
+
+	return acc * XXH_PRIME32_1;
+}
+
+/* XXH32 hash with a seed of 0, used for all the LZ4 frame checksums */
+static uint32_t xxh32(const uint8_t *p, size_t len)
+{
+	const uint8_t *end = p + len;
+	uint32_t h;
+
+	if (len >= 16U) {
+		uint32_t v1 = XXH_PRIME32_1 + XXH_PRIME32_2;
+		uint32_t v2 = XXH_PRIME32_2;
+		uint32_t v3 = 0U;
+		uint32_t v4 = 0U - XXH_PRIME32_1;
+
+		do {
+			v1 = xxh32_round(v1, load_le32(p));
+			v2 = xxh32_round(v2, load_le32(p + 4));
+			v3 = xxh32_round(v3, load_le32(p + 8));
+			v4 = xxh32_round(v4, load_le32(p + 12));
+			p += 16;
+		} while ((size_t)(end - p) >= 16U);
+
+		h = ROTL32(v1, 1U) + ROTL32(v2, 7U) +
+		    ROTL32(v3, 12U) + ROTL32(v4, 18U);
+	} else {
+		h = XXH_PRIME32_5;
+	}
+
+	h += (uint32_t)len;
+
+	while ((size_t)(end - p) >= 4U) {
+		h += load_le32(p) * XXH_PRIME32_3;
+		h = ROTL32(h, 17U) * XXH_PRIME32_4;
+		p += 4;
+	}
+
+	while (p < end) {
+		h += (uint32_t)(*p++) * XXH_PRIME32_5;
+		h = ROTL32(h, 11U) * XXH_PRIME32_1;
+	}
+
+	h ^= h >> 15;
+	h *= XXH_PRIME32_2;
+	h ^= h >> 13;
+	h *= XXH_PRIME32_3;
+	h ^= h >> 16;
+
+	return h;
+}
+
+/*
+ * Copy 'len' literal bytes. Long runs use memcpy(), which copies whole words
+ * when the alignment of the source and the destination allow it.
+ */
+static inline uint8_t *copy_literals(uint8_t *out, const uint8_t *src,
+				     size_t len)
+{
+	if (len < LZ4_MIN_MEMCPY) {
+		while (len-- != 0U)
+			*out++ = *src++;
+		return out;
+	}
+
+	memcpy(out, src, len);
+
+	return out + len;
+}
+
+/*
+ * Copy a match of 'len' bytes, 'len' >= LZ4_MIN_MATCH, from 'offset' bytes
+ * back in the output. Return the updated output pointer.
+ */
+static inline uint8_t *copy_match(uint8_t *out, size_t offset, size_t len)
+{
+	const uint8_t *from = out - offset;
+
+	if (len < LZ4_MIN_MEMCPY) {
+		do {
+			*out++ = *from++;
+		} while (--len != 0U);
+
+		return out;
+	}
+
+	if (offset == 1U) {
+		memset(out, *from, len);
+		return out + len;
+	}
+
+	/*
+	 * After each chunk, the bytes from 'from' to 'out' hold a whole number
+	 * of repetitions of the pattern, so twice as many can be copied at once.
+	 */
+	while (offset < len) {
+		memcpy(out, from, offset);
+		out += offset;
+		len -= offset;
+		offset += offset;
+	}
+	memcpy(out, from, len);
+
+	return out + len;
+}
+
+/* Read the extension of a literal or match length, 255 adds per byte */
+static int read_length(const uint8_t **src, const uint8_t *src_end,
+		       size_t *len)
+{
+	const uint8_t *p = *src;
+	unsigned int b;
+
+	do {
+		if (p == src_end)
+			return -EIO;
+		b = *p++;
+		*len += b;
+	} while (b == 255U);
+
+	*src = p;
+
+	return 0;
+}
+
+/* Decode the sequences of a compressed block */
+static int lz4_decode_block(const uint8_t *src, size_t len)
+{
+	const uint8_t *src_end = src + len;
+	uint8_t *out = lz4_stream.out;
+	uint8_t *out_end = lz4_stream.out_end;
+	size_t lit_len, match_len, offset;
+	unsigned int token;
+
+	do {
+		token = *src++;
+
+		lit_len = token >> 4;
+		if ((lit_len == 15U) &&
+		    (read_length(&src, src_end, &lit_len) != 0))
+			goto corrupted;
+
+		if (lit_len > (size_t)(src_end - src))
+			goto corrupted;
+		if (lit_len > (size_t)(out_end - out))
+			goto too_small;
+		out = copy_literals(out, src, lit_len);
+		src += lit_len;
+
+		/* The last sequence of a block has no match */
+		if (src == src_end)
+			break;
+
+		if ((size_t)(src_end - src) < 2U)
+			goto corrupted;
+		offset = (size_t)src[0] | ((size_t)src[1] << 8);
+		src += 2;
+		if ((offset == 0U) ||
+		    (offset > (size_t)(out - lz4_stream.out_start)))
+			goto corrupted;
+
+		match_len = token & 15U;
+		if ((match_len == 15U) &&
+		    (read_length(&src, src_end, &match_len) != 0))
+			goto corrupted;
+		match_len += LZ4_MIN_MATCH;
+
+		if (match_len > (size_t)(out_end - out))
+			goto too_small;
+		out = copy_match(out, offset, match_len);
+	} while (src < src_end);
+
+	lz4_stream.out = out;
+
+	return 0;
+
+corrupted:
+	ERROR("lz4: corrupted block\n");
+	return -EIO;
+
+too_small:
+	ERROR("lz4: output buffer too small\n");
+	return -EIO;
+}
+
+/*
+ * Check and decode a block of 'len' bytes, including its checksum if the frame
+ * has them. The block size word is still in 'field'.
+ */
+static int lz4_process_block(const uint8_t *src, size_t len)
+{
+	if ((lz4_stream.flags & LZ4_FLG_BLOCK_CHECKSUM) != 0U) {
+		len -= 4U;
+		if (xxh32(src, len) != read_le32(src + len)) {
+			ERROR("lz4: block checksum mismatch\n");
+			return -EIO;
+		}
+	}
+
+	if ((read_le32(lz4_stream.field) & LZ4_BLOCK_UNCOMPRESSED) == 0U)
+		return lz4_decode_block(src, len);
+
+	if (len > (size_t)(lz4_stream.out_end - lz4_stream.out)) {
+		ERROR("lz4: output buffer too small\n");
+		return -EIO;
+	}
+	lz4_stream.out = copy_literals(lz4_stream.out, src, len);
+
+	return 0;
+}
+
+/* Check the frame header, once its first 6 bytes or all of it are gathered */
+static int lz4_process_header(void)
+{
+	const uint8_t *hdr = lz4_stream.field;
+	uint8_t flags = hdr[4];
+	uint8_t bd = hdr[5];
+
+	if (read_le32(hdr) != LZ4_FRAME_MAGIC) {
+		ERROR("lz4: not an LZ4 frame\n");
+		return -EIO;
+	}
+
+	if (((flags & (LZ4_FLG_VERSION_MASK | LZ4_FLG_RESERVED)) !=
+	     LZ4_FLG_VERSION) || ((bd & LZ4_BD_RESERVED) != 0U) ||
+	    (((bd >> LZ4_BD_MAX_SIZE_SHIFT) & LZ4_BD_MAX_SIZE_MASK) < 4U)) {
+		ERROR("lz4: invalid frame header\n");
+		return -EIO;
+	}
+
+	if ((flags & LZ4_FLG_DICT_ID) != 0U) {
+		ERROR("lz4: preset dictionaries are not supported\n");
+		return -ENOTSUP;
+	}
+
+	if (lz4_stream.need == LZ4_HEADER_START_LEN) {
+		/* Gather the content size, if any, and the header checksum */
+		lz4_stream.need += 1U;
+		if ((flags & LZ4_FLG_CONTENT_SIZE) != 0U)
+			lz4_stream.need += 8U;
+		return 0;
+	}
+
+	if (((xxh32(hdr + 4, lz4_stream.need - 5U) >> 8) & 0xFFU) !=
+	    hdr[lz4_stream.need - 1U]) {
+		ERROR("lz4: header checksum mismatch\n");
+		return -EIO;
+	}
+
+	lz4_stream.flags = flags;
+	/* 64KB, 256KB, 1MB or 4MB */
+	lz4_stream.block_max = (size_t)1U <<
+		(8U + (2U * ((bd >> LZ4_BD_MAX_SIZE_SHIFT) &
+			     LZ4_BD_MAX_SIZE_MASK)));
+
+	if ((flags & LZ4_FLG_CONTENT_SIZE) != 0U) {
+		lz4_stream.content_size = (uint64_t)read_le32(hdr + 6) |
+					  ((uint64_t)read_le32(hdr + 10) << 32);
+		if (lz4_stream.content_size >
+		    (uint64_t)(lz4_stream.out_end - lz4_stream.out_start)) {
+			ERROR("lz4: output buffer too small\n");
+			return -EIO;
+		}
+	}
+
+	lz4_stream.state = LZ4_STATE_BLOCK_SIZE;
+	lz4_stream.need = 4U;
+
+	return 0;
+}
+
+/* Process the item that has been gathered and select the next one */
+static int lz4_process_field(const uint8_t *data)
+{
+	size_t out_size = (size_t)(lz4_stream.out - lz4_stream.out_start);
+	uint32_t word;
+	int ret;
+
+	switch (lz4_stream.state) {
+	case LZ4_STATE_HEADER:
+		return lz4_process_header();
+
+	case LZ4_STATE_BLOCK_SIZE:
+		word = read_le32(data);
+		if (word == 0U) {
+			/* End mark */
+			if (((lz4_stream.flags & LZ4_FLG_CONTENT_SIZE) != 0U) &&
+			    (lz4_stream.content_size != out_size)) {
+				ERROR("lz4: content size mismatch\n");
+				return -EIO;
+			}
+			if ((lz4_stream.flags & LZ4_FLG_CONTENT_CHECKSUM) !=
+			    0U) {
+				lz4_stream.state = LZ4_STATE_CONTENT_CHECKSUM;
+				lz4_stream.need = 4U;
+			} else {
+				lz4_stream.state = LZ4_STATE_END;
+			}
+			return 0;
+		}
+
+		word &= ~LZ4_BLOCK_UNCOMPRESSED;
+		if ((word == 0U) || (word > lz4_stream.block_max)) {
+			ERROR("lz4: invalid block size\n");
+			return -EIO;
+		}
+		lz4_stream.state = LZ4_STATE_BLOCK;
+		lz4_stream.need = word;
+		if ((lz4_stream.flags & LZ4_FLG_BLOCK_CHECKSUM) != 0U)
+			lz4_stream.need += 4U;
+		return 0;
+
+	case LZ4_STATE_BLOCK:
+		ret = lz4_process_block(data, lz4_stream.need);
+		lz4_stream.state = LZ4_STATE_BLOCK_SIZE;
+		lz4_stream.need = 4U;
+		return ret;
+
+	case LZ4_STATE_CONTENT_CHECKSUM:
+		if (xxh32(lz4_stream.out_start, out_size) != read_le32(data)) {
+			ERROR("lz4: content checksum mismatch\n");
+			return -EIO;
+		}
+		lz4_stream.state = LZ4_STATE_END;
+		return 0;
+
+	default:
+		return -EIO;
+	}
+}
+
+/*
+ * lz4_stream_start - start decompressing an LZ4 frame passed in chunks
+ * @out_buf: destination of decompressed output
+ * @out_len: length of out_buf
+ * @work_buf: workspace, for the blocks split across chunks
+ * @work_len: length of workspace
+ */
+int lz4_stream_start(uintptr_t out_buf, size_t out_len,
+		     uintptr_t work_buf, size_t work_len)
+{
+	memset(&lz4_stream, 0, sizeof(lz4_stream));
+	lz4_stream.state = LZ4_STATE_HEADER;
+	lz4_stream.out_start = (uint8_t *)out_buf;
+	lz4_stream.out = (uint8_t *)out_buf;
+	lz4_stream.out_end = (uint8_t *)(out_buf + out_len);
+	lz4_stream.work = (uint8_t *)work_buf;
+	lz4_stream.work_len = work_len;
+	lz4_stream.need = LZ4_HEADER_START_LEN;
+
+	return 0;
+}
+
+/*
+ * lz4_stream_update - decompress the next chunk of an LZ4 frame
+ * @in_buf: next chunk of compressed input
+ * @in_len: length of in_buf
+ *
+ * Any data following the end of the frame is ignored.
+ */
+int lz4_stream_update(uintptr_t in_buf, size_t in_len)
+{
+	const uint8_t *in = (const uint8_t *)in_buf;
+	uint8_t *dst;
+	size_t n;
+	int ret = 0;
+
+	if (lz4_stream.ret < 0)
+		return lz4_stream.ret;
+
+	while ((in_len != 0U) && (lz4_stream.state != LZ4_STATE_END)) {
+		n = lz4_stream.need - lz4_stream.have;
+
+		if (lz4_stream.state == LZ4_STATE_BLOCK) {
+			if ((lz4_stream.have == 0U) && (in_len >= n)) {
+				/* The whole block is there, decode it in place */
+				ret = lz4_process_field(in);
+				in += n;
+				in_len -= n;
+				lz4_stream.total_in += n;
+				if (ret != 0)
+					break;
+				continue;
+			}
+
+			if (lz4_stream.need > lz4_stream.work_len) {
+				ERROR("lz4: work buffer too small\n");
+				ret = -ENOMEM;
+				break;
+			}
+			dst = lz4_stream.work;
+		} else {
+			dst = lz4_stream.field;
+		}
+
+		n = MIN(n, in_len);
+		memcpy(dst + lz4_stream.have, in, n);
+		in += n;
+		in_len -= n;
+		lz4_stream.total_in += n;
+		lz4_stream.have += n;
+		if (lz4_stream.have < lz4_stream.need)
+			break;
+
+		ret = lz4_process_field(dst);
+		if (ret != 0)
+			break;
+
+		/* The header is gathered in two steps */
+		if (lz4_stream.state != LZ4_STATE_HEADER)
+			lz4_stream.have = 0U;
+	}
+
+	lz4_stream.ret = ret;
+
+	return ret;
+}
+
+/*
+ * lz4_stream_finish - finish decompressing an LZ4 frame
+ * @out_buf: upon exit, the end of output
+ *
+ * Returns an error if the end of the frame has not been reached.
+ */
+int lz4_stream_finish(uintptr_t *out_buf)
+{
+	int ret = lz4_stream.ret;
+
+	if ((ret == 0) && (lz4_stream.state != LZ4_STATE_END)) {
+		ERROR("lz4: truncated input\n");
+		ret = -EIO;
+	}
+
+	VERBOSE("lz4: %lu byte input\n", (unsigned long)lz4_stream.total_in);
+	VERBOSE("lz4: %lu byte output\n",
+		(unsigned long)(lz4_stream.out - lz4_stream.out_start));
+
+	*out_buf = (uintptr_t)lz4_stream.out;
+
+	return ret;
+}
+
+/*
+ * lz4_decompress - decompress an LZ4 frame
+ * @in_buf: source of compressed input. Upon exit, the end of input.
+ * @in_len: length of in_buf
+ * @out_buf: destination of decompressed output. Upon exit, the end of output.
+ * @out_len: length of out_buf
+ * @work_buf: workspace
+ * @work_len: length of workspace
+ */
+int lz4_decompress(uintptr_t *in_buf, size_t in_len, uintptr_t *out_buf,
+		   size_t out_len, uintptr_t work_buf, size_t work_len)
+{
+	int ret;
+
+	ret = lz4_stream_start(*out_buf, out_len, work_buf, work_len);
+	if (ret != 0)
+		return ret;
+
+	lz4_stream_update(*in_buf, in_len);
+	*in_buf += lz4_stream.total_in;
+
+	return lz4_stream_finish(out_buf);
+}
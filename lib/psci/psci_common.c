@@ -58,6 +58,39 @@ __section("tzfw_coherent_mem")
 /* Lock for PSCI state coordination */
 DEFINE_PSCI_LOCK(psci_locks[PSCI_NUM_NON_CPU_PWR_DOMAINS]);
 
+#if PSCI_ATOMIC_COORDINATION
+/*
+ * Coordination word of each non CPU power domain, used instead of the locks
+ * when PSCI_ATOMIC_COORDINATION is enabled. The low bits count the children
+ * of the power domain that are running: CPUs at level 1, power domains at the
+ * levels above. Each word is updated with a compare-and-swap. The CPU that
+ * makes a count drop to zero (the last one going down) or rise from zero (the
+ * first one coming up) sets the BUSY bit, which holds the power domain until
+ * the platform has changed its power state. Other CPUs only wait for the
+ * power domains held this way. PARENT_OFF records that the last CPU going
+ * down also left the parent power domain, which the first CPU coming up has
+ * to rejoin.
+ */
+#define PSCI_COORD_BUSY		(U(1) << 31)
+#define PSCI_COORD_PARENT_OFF	(U(1) << 30)
+#define PSCI_COORD_COUNT_MASK	U(0xffff)
+#define PSCI_COORD_COUNT(word)	((word) & PSCI_COORD_COUNT_MASK)
+
+typedef struct psci_coord {
+	uint32_t word;
+} __aligned(CACHE_WRITEBACK_GRANULE) psci_coord_t;
+
+static psci_coord_t psci_coord_nodes[PSCI_NUM_NON_CPU_PWR_DOMAINS];
+
+/* Highest power level of the power domains held by each CPU */
+static unsigned int psci_coord_held_lvl[PLATFORM_CORE_COUNT];
+
+CASSERT(PLATFORM_CORE_COUNT <= PSCI_COORD_COUNT_MASK,
+	assert_psci_coord_count_fits);
+CASSERT(PLAT_MAX_PWR_LVL > PSCI_CPU_PWR_LVL,
+	assert_psci_coord_non_cpu_pwr_lvl);
+#endif
+
 cpu_pd_node_t psci_cpu_pd_nodes[PLATFORM_CORE_COUNT];
 
 /*******************************************************************************
@@ -228,6 +261,15 @@ void psci_init_req_local_pwr_states(void)
 				PLAT_MAX_OFF_STATE;
 		}
 	}
+
+#if PSCI_ATOMIC_COORDINATION
+	/*
+	 * All power domains start without running children, as if every CPU
+	 * had been turned off. The primary CPU rejoins them during setup.
+	 */
+	for (unsigned int i = 0U; i < PSCI_NUM_NON_CPU_PWR_DOMAINS; i++)
+		psci_coord_nodes[i].word = PSCI_COORD_PARENT_OFF;
+#endif
 }
 
 /******************************************************************************
@@ -316,6 +358,7 @@ void psci_get_target_local_pwr_states(unsigned int end_pwrlvl,
 		target_state->pwr_domain_state[lvl] = PSCI_LOCAL_STATE_RUN;
 }
 
+#if !PSCI_ATOMIC_COORDINATION
 /******************************************************************************
  * Helper function to set the target local power state that each power domain
  * from the current cpu power domain to its ancestor at the 'end_pwrlvl' will
@@ -344,6 +387,7 @@ static void psci_set_target_local_pwr_states(unsigned int end_pwrlvl,
 		parent_idx = psci_non_cpu_pd_nodes[parent_idx].parent_node;
 	}
 }
+#endif
 
 
 /*******************************************************************************
@@ -391,6 +435,136 @@ void psci_set_pwr_domains_to_run(unsigned int end_pwrlvl)
 	psci_flush_cpu_data(psci_svc_cpu_data);
 }
 
+#if PSCI_ATOMIC_COORDINATION
+/******************************************************************************
+ * Add 'delta' to the number of running children of a power domain once it is
+ * not held by another CPU. If the count drops to zero or rises from zero, the
+ * calling CPU holds the power domain on return. Returns the coordination word
+ * as it was before the update.
+ *****************************************************************************/
+static uint32_t psci_coord_add(unsigned int node_idx, int delta)
+{
+	volatile uint32_t *word = &psci_coord_nodes[node_idx].word;
+	uint32_t old, new;
+
+	for (;;) {
+		old = *word;
+		if ((old & PSCI_COORD_BUSY) != 0U)
+			continue;
+
+		assert((delta > 0) || (PSCI_COORD_COUNT(old) != 0U));
+		new = old + (uint32_t) delta;
+		if ((PSCI_COORD_COUNT(old) == 0U) ||
+		    (PSCI_COORD_COUNT(new) == 0U))
+			new |= PSCI_COORD_BUSY;
+
+		if (psci_coord_cas(word, old, new) == old)
+			return old;
+	}
+}
+
+/******************************************************************************
+ * Set or clear the PARENT_OFF flag of a power domain held by the calling CPU.
+ * No other CPU updates the word while it is held.
+ *****************************************************************************/
+static void psci_coord_set_parent_off(unsigned int node_idx, bool parent_off)
+{
+	volatile uint32_t *word = &psci_coord_nodes[node_idx].word;
+
+	assert((*word & PSCI_COORD_BUSY) != 0U);
+
+	if (parent_off)
+		*word |= PSCI_COORD_PARENT_OFF;
+	else
+		*word &= ~PSCI_COORD_PARENT_OFF;
+}
+
+/******************************************************************************
+ * This function is the lock-free counterpart of the coordination below. The
+ * requested local power states are recorded for each level until 'end_pwrlvl'
+ * first, then the CPU leaves the power domains it does not want to keep
+ * running, from level 1 upwards. Only the last CPU leaving a power domain
+ * coordinates its target state with the platform, and only while that
+ * power domain is held; the target state of the power domains that keep
+ * running children is RUN.
+ *
+ * The 'state_info' is updated with the target state for each level between the
+ * CPU and the 'end_pwrlvl' and returned to the caller. The power domains held
+ * by the CPU are given back by psci_release_pwr_domain_locks().
+ *
+ * This function will only be invoked with data cache enabled and while
+ * powering down a core.
+ *****************************************************************************/
+void psci_do_state_coordination(unsigned int end_pwrlvl,
+				psci_power_state_t *state_info)
+{
+	unsigned int lvl, parent_idx, child_idx = 0U;
+	unsigned int cpu_idx = plat_my_core_pos();
+	int start_idx;
+	unsigned int ncpus;
+	plat_local_state_t target_state, *req_states;
+	uint32_t old;
+
+	assert(end_pwrlvl <= PLAT_MAX_PWR_LVL);
+	parent_idx = psci_cpu_pd_nodes[cpu_idx].parent_node;
+
+	/* Publish the requested states before leaving any power domain */
+	for (lvl = PSCI_CPU_PWR_LVL + 1U; lvl <= end_pwrlvl; lvl++) {
+		psci_set_req_local_pwr_state(lvl, cpu_idx,
+					     state_info->pwr_domain_state[lvl]);
+	}
+
+	for (lvl = PSCI_CPU_PWR_LVL + 1U; lvl <= end_pwrlvl; lvl++) {
+
+		/* Power domains requested to stay in RUN are not left */
+		if (is_local_state_run(state_info->pwr_domain_state[lvl]) != 0)
+			break;
+
+		/* The child power domain held below leaves this one */
+		if (lvl > (PSCI_CPU_PWR_LVL + 1U))
+			psci_coord_set_parent_off(child_idx, true);
+
+		old = psci_coord_add(parent_idx, -1);
+		if (PSCI_COORD_COUNT(old) != 1U) {
+			/* Other children keep this power domain running */
+			state_info->pwr_domain_state[lvl] = PSCI_LOCAL_STATE_RUN;
+			break;
+		}
+
+		/* Last one out, this CPU now holds the power domain */
+		psci_coord_held_lvl[cpu_idx] = lvl;
+
+		start_idx = psci_non_cpu_pd_nodes[parent_idx].cpu_start_idx;
+		req_states = psci_get_req_local_pwr_states(lvl, start_idx);
+		ncpus = psci_non_cpu_pd_nodes[parent_idx].ncpus;
+		target_state = plat_get_target_pwr_state(lvl,
+							 req_states,
+							 ncpus);
+
+		state_info->pwr_domain_state[lvl] = target_state;
+		set_non_cpu_pd_node_local_state(parent_idx, target_state);
+
+		/* Break early if the negotiated target power state is RUN */
+		if (is_local_state_run(target_state) != 0)
+			break;
+
+		child_idx = parent_idx;
+		parent_idx = psci_non_cpu_pd_nodes[parent_idx].parent_node;
+	}
+
+	/* The power domains above the last one left stay in RUN */
+	for (lvl = lvl + 1U; lvl <= end_pwrlvl; lvl++)
+		state_info->pwr_domain_state[lvl] = PSCI_LOCAL_STATE_RUN;
+
+	psci_set_cpu_local_state(state_info->pwr_domain_state[PSCI_CPU_PWR_LVL]);
+
+	/*
+	 * Need to flush as local_state might be accessed with Data Cache
+	 * disabled during power on
+	 */
+	psci_flush_cpu_data(psci_svc_cpu_data.local_state);
+}
+#else
 /******************************************************************************
  * This function is passed the local power states requested for each power
  * domain (state_info) between the current CPU domain and its ancestors until
@@ -468,6 +642,7 @@ void psci_do_state_coordination(unsigned int end_pwrlvl,
 	/* Update the target state in the power domain nodes */
 	psci_set_target_local_pwr_states(end_pwrlvl, state_info);
 }
+#endif /* PSCI_ATOMIC_COORDINATION */
 
 /******************************************************************************
  * This function validates a suspend request by making sure that if a standby
@@ -565,6 +740,78 @@ unsigned int psci_find_target_suspend_lvl(const psci_power_state_t *state_info)
 	return PSCI_INVALID_PWR_LVL;
 }
 
+#if PSCI_ATOMIC_COORDINATION
+/*******************************************************************************
+ * With atomic coordination, this function makes a CPU that is powering up
+ * rejoin the power domains it left while powering down, in order of increasing
+ * power level. The CPU holds each power domain it is the first to come back
+ * to, so the power domains being powered up are snapshot until the matching
+ * release. A CPU going down still requests RUN for all its ancestors, so this
+ * is a no-op on the power down paths, where psci_do_state_coordination() does
+ * the work.
+ *
+ * A power domain whose parent was left is always rejoined up to its parent,
+ * even above 'end_pwrlvl', to keep the counts balanced. The platform only
+ * powered off such a parent if this CPU requested it, so 'end_pwrlvl' covers
+ * the levels that need to be powered up.
+ ******************************************************************************/
+void psci_acquire_pwr_domain_locks(unsigned int end_pwrlvl, int cpu_idx)
+{
+	unsigned int parent_idx = psci_cpu_pd_nodes[cpu_idx].parent_node;
+	unsigned int level;
+	uint32_t old;
+
+	if (is_local_state_run(*psci_get_req_local_pwr_states(
+			PSCI_CPU_PWR_LVL + 1U, cpu_idx)) != 0)
+		return;
+
+	for (level = PSCI_CPU_PWR_LVL + 1U; level <= PLAT_MAX_PWR_LVL;
+	     level++) {
+		old = psci_coord_add(parent_idx, 1);
+		if (PSCI_COORD_COUNT(old) != 0U)
+			break;
+
+		/* First one in, this CPU now holds the power domain */
+		psci_coord_held_lvl[cpu_idx] = level;
+
+		if ((old & PSCI_COORD_PARENT_OFF) == 0U)
+			break;
+
+		psci_coord_set_parent_off(parent_idx, false);
+		parent_idx = psci_non_cpu_pd_nodes[parent_idx].parent_node;
+	}
+}
+
+/*******************************************************************************
+ * This function releases the power domains held by a CPU after coordination, in
+ * order of decreasing power domain level.
+ ******************************************************************************/
+void psci_release_pwr_domain_locks(unsigned int end_pwrlvl, int cpu_idx)
+{
+	unsigned int parent_idx, parent_nodes[PLAT_MAX_PWR_LVL] = {0};
+	unsigned int level, held_lvl = psci_coord_held_lvl[cpu_idx];
+	volatile uint32_t *word;
+
+	if (held_lvl == PSCI_CPU_PWR_LVL)
+		return;
+
+	psci_get_parent_pwr_domain_nodes(cpu_idx, held_lvl, parent_nodes);
+
+	/*
+	 * Make the updates done while holding the power domains visible
+	 * before giving them back.
+	 */
+	dmbish();
+
+	for (level = held_lvl; level >= PSCI_CPU_PWR_LVL + 1U; level--) {
+		parent_idx = parent_nodes[level - 1U];
+		word = &psci_coord_nodes[parent_idx].word;
+		*word &= ~PSCI_COORD_BUSY;
+	}
+
+	psci_coord_held_lvl[cpu_idx] = PSCI_CPU_PWR_LVL;
+}
+#else
 /*******************************************************************************
  * This function is passed a cpu_index and the highest level in the topology
  * tree that the operation should be applied to. It picks up locks in order of
@@ -601,6 +848,7 @@ void psci_release_pwr_domain_locks(unsigned int end_pwrlvl, int cpu_idx)
 		psci_lock_release(&psci_non_cpu_pd_nodes[parent_idx]);
 	}
 }
+#endif /* PSCI_ATOMIC_COORDINATION */
 
 /*******************************************************************************
  * Simple routine to determine whether a mpidr is valid or not.
@@ -1022,6 +1270,11 @@ int psci_get_suspend_afflvl(void)
  ******************************************************************************/
 void psci_do_pwrdown_sequence(unsigned int power_level)
 {
+#if CTX_LAZY_FPREGS
+	/* The FP registers lose their state when the CPU is powered down */
+	cm_fpregs_lazy_save();
+#endif
+
 #if HW_ASSISTED_COHERENCY
 	/*
 	 * With hardware-assisted coherency, the CPU drivers only initiate the
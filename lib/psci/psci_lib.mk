@@ -24,7 +24,10 @@ ifeq (${ARCH}, aarch64)
 PSCI_LIB_SOURCES	+=	lib/el3_runtime/aarch64/context.S
 endif
 
-ifeq (${USE_COHERENT_MEM}, 1)
+ifeq (${USE_QUEUED_BAKERY_LOCK}, 1)
+PSCI_LIB_SOURCES		+=	lib/locks/bakery/bakery_lock_queued.c	\
+				lib/locks/exclusive/${ARCH}/bakery_ticket.S
+else ifeq (${USE_COHERENT_MEM}, 1)
 PSCI_LIB_SOURCES		+=	lib/locks/bakery/bakery_lock_coherent.c
 else
 PSCI_LIB_SOURCES		+=	lib/locks/bakery/bakery_lock_normal.c
@@ -48,6 +48,67 @@ int psci_cpu_on(u_register_t target_cpu,
 	return psci_cpu_on_start(target_cpu, &ep);
 }
 
+/*******************************************************************************
+ * Turn on several cpus with a single call. The cpus share the affinity levels
+ * above level 0 of 'target_base', and bit n of 'target_map' selects the cpu
+ * whose affinity level 0 is n. All the cpus start at the same entrypoint, with
+ * the same context id.
+ *
+ * Nothing is done if a cpu does not exist or the entrypoint is invalid.
+ * Otherwise the cpus are turned on in turn, and the error of the first one
+ * which could not be turned on is returned. The cpus that have been turned on
+ * are returned in 'on_map'.
+ ******************************************************************************/
+int psci_cpu_on_batch(u_register_t target_base,
+		      u_register_t target_map,
+		      uintptr_t entrypoint,
+		      u_register_t context_id,
+		      u_register_t *on_map)
+{
+	int rc, ret = PSCI_E_SUCCESS;
+	unsigned int aff0;
+	u_register_t target_cpu;
+	entry_point_info_t ep;
+
+	assert(on_map != NULL);
+	*on_map = 0U;
+
+	if (target_map == 0U)
+		return PSCI_E_INVALID_PARAMS;
+
+	target_base &= MPIDR_AFFINITY_MASK &
+		~(MPIDR_AFFLVL_MASK << MPIDR_AFF0_SHIFT);
+
+	/* Determine if all the cpus exist */
+	for (aff0 = 0U; aff0 < (sizeof(target_map) * 8U); aff0++) {
+		if ((target_map & ((u_register_t)1U << aff0)) == 0U)
+			continue;
+
+		target_cpu = target_base | ((u_register_t)aff0 << MPIDR_AFF0_SHIFT);
+		if (psci_validate_mpidr(target_cpu) != PSCI_E_SUCCESS)
+			return PSCI_E_INVALID_PARAMS;
+	}
+
+	/* Validate the entry point once for all the cpus */
+	rc = psci_validate_entry_point(&ep, entrypoint, context_id);
+	if (rc != PSCI_E_SUCCESS)
+		return rc;
+
+	for (aff0 = 0U; aff0 < (sizeof(target_map) * 8U); aff0++) {
+		if ((target_map & ((u_register_t)1U << aff0)) == 0U)
+			continue;
+
+		target_cpu = target_base | ((u_register_t)aff0 << MPIDR_AFF0_SHIFT);
+		rc = psci_cpu_on_start(target_cpu, &ep);
+		if (rc == PSCI_E_SUCCESS)
+			*on_map |= (u_register_t)1U << aff0;
+		else if (ret == PSCI_E_SUCCESS)
+			ret = rc;
+	}
+
+	return ret;
+}
+
 unsigned int psci_version(void)
 {
 	return PSCI_MAJOR_VER | PSCI_MINOR_VER;
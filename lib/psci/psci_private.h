@@ -285,6 +285,12 @@ unsigned int psci_is_last_on_cpu(void);
 int psci_spd_migrate_info(u_register_t *mpidr);
 void psci_do_pwrdown_sequence(unsigned int power_level);
 
+#if PSCI_ATOMIC_COORDINATION
+/* Private exported functions from psci_helpers.S */
+uint32_t psci_coord_cas(volatile uint32_t *addr, uint32_t expected,
+			uint32_t desired);
+#endif
+
 /*
  * CPU power down is directly called only when HW_ASSISTED_COHERENCY is
  * available. Otherwise, this needs post-call stack maintenance, which is
@@ -208,12 +208,23 @@ int psci_setup(const psci_lib_args_t *lib_args)
 
 	psci_init_req_local_pwr_states();
 
+#if PSCI_ATOMIC_COORDINATION
+	/* Make this CPU join the power domains it belongs to */
+	psci_acquire_pwr_domain_locks(PLAT_MAX_PWR_LVL,
+				      (int) plat_my_core_pos());
+#endif
+
 	/*
 	 * Set the requested and target state of this CPU and all the higher
 	 * power domain levels for this CPU to run.
 	 */
 	psci_set_pwr_domains_to_run(PLAT_MAX_PWR_LVL);
 
+#if PSCI_ATOMIC_COORDINATION
+	psci_release_pwr_domain_locks(PLAT_MAX_PWR_LVL,
+				      (int) plat_my_core_pos());
+#endif
+
 	(void) plat_setup_psci_ops((uintptr_t)lib_args->mailbox_ep,
 				   &psci_plat_pm_ops);
 	assert(psci_plat_pm_ops != NULL);
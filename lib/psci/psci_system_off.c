@@ -9,12 +9,16 @@
 #include <console.h>
 #include <debug.h>
 #include <platform.h>
+#include <runtime_svc.h>
 #include <stddef.h>
 #include "psci_private.h"
 
 void __dead2 psci_system_off(void)
 {
 	psci_print_power_domain_map();
+#if ENABLE_SMC_STAT
+	runtime_svc_stat_print();
+#endif
 
 	assert(psci_plat_pm_ops->system_off != NULL);
 
@@ -34,6 +38,9 @@ void __dead2 psci_system_off(void)
 void __dead2 psci_system_reset(void)
 {
 	psci_print_power_domain_map();
+#if ENABLE_SMC_STAT
+	runtime_svc_stat_print();
+#endif
 
 	assert(psci_plat_pm_ops->system_reset != NULL);
 
@@ -55,6 +62,9 @@ u_register_t psci_system_reset2(uint32_t reset_type, u_register_t cookie)
 	unsigned int is_vendor;
 
 	psci_print_power_domain_map();
+#if ENABLE_SMC_STAT
+	runtime_svc_stat_print();
+#endif
 
 	assert(psci_plat_pm_ops->system_reset2 != NULL);
 
@@ -90,6 +90,41 @@ void xlat_arch_tlbi_va(uintptr_t va, int xlat_regime)
 	}
 }
 
+void xlat_arch_tlbi_va_range(uintptr_t va, size_t size, int xlat_regime)
+{
+	size_t pages = size >> PAGE_SIZE_SHIFT;
+
+	assert((va & PAGE_SIZE_MASK) == 0U);
+	assert((size & PAGE_SIZE_MASK) == 0U);
+
+	/*
+	 * Ensure the translation table writes have drained into memory before
+	 * invalidating the TLB entries.
+	 */
+	dsbishst();
+
+	/* AArch32 has no TLBI range instructions. */
+	if (pages > PLAT_XLAT_TLBI_MAX_PAGES) {
+		if (xlat_regime == EL1_EL0_REGIME) {
+			tlbiallis();
+		} else {
+			assert(xlat_regime == EL2_REGIME);
+			tlbiallhis();
+		}
+		return;
+	}
+
+	for (; pages > 0U; pages--) {
+		if (xlat_regime == EL1_EL0_REGIME) {
+			tlbimvaais(TLBI_ADDR(va));
+		} else {
+			assert(xlat_regime == EL2_REGIME);
+			tlbimvahis(TLBI_ADDR(va));
+		}
+		va += PAGE_SIZE;
+	}
+}
+
 void xlat_arch_tlbi_va_sync(void)
 {
 	/* Invalidate all entries from branch predictors. */
@@ -139,14 +139,18 @@ uint64_t xlat_arch_regime_get_xn_desc(int xlat_regime)
 	}
 }
 
-void xlat_arch_tlbi_va(uintptr_t va, int xlat_regime)
-{
-	/*
-	 * Ensure the translation table write has drained into memory before
-	 * invalidating the TLB entry.
-	 */
-	dsbishst();
+/*
+ * Largest number of pages that the TLBI range instructions can invalidate
+ * with at most one instruction per scale, plus one page.
+ */
+#define XLAT_TLBI_RANGE_MAX_PAGES	(TLBI_RANGE_PAGES(3U, 31U) - 1ULL)
 
+/*
+ * Invalidate the TLB entries that match the given virtual address, without
+ * waiting for the translation table writes to drain.
+ */
+static void xlat_arch_tlbi_va_nodrain(uintptr_t va, int xlat_regime)
+{
 	/*
 	 * This function only supports invalidation of TLB entries for the EL3
 	 * and EL1&0 translation regimes.
@@ -167,6 +171,110 @@ void xlat_arch_tlbi_va(uintptr_t va, int xlat_regime)
 	}
 }
 
+void xlat_arch_tlbi_va(uintptr_t va, int xlat_regime)
+{
+	/*
+	 * Ensure the translation table write has drained into memory before
+	 * invalidating the TLB entry.
+	 */
+	dsbishst();
+
+	xlat_arch_tlbi_va_nodrain(va, xlat_regime);
+}
+
+/* Returns true if the TLBI range instructions are implemented. */
+static bool is_tlbi_range_present(void)
+{
+	return ((read_id_aa64isar0_el1() >> ID_AA64ISAR0_TLB_SHIFT) &
+		ID_AA64ISAR0_TLB_MASK) >= ID_AA64ISAR0_TLB_RANGE;
+}
+
+/* Invalidate all the TLB entries of the translation regime. */
+static void xlat_arch_tlbi_all(int xlat_regime)
+{
+	if (xlat_regime == EL1_EL0_REGIME) {
+		assert(xlat_arch_current_el() >= 1U);
+		tlbivmalle1is();
+	} else if (xlat_regime == EL2_REGIME) {
+		assert(xlat_arch_current_el() >= 2U);
+		tlbialle2is();
+	} else {
+		assert(xlat_regime == EL3_REGIME);
+		assert(xlat_arch_current_el() >= 3U);
+		tlbialle3is();
+	}
+}
+
+/* Invalidate 'pages' pages from the given address with range instructions. */
+static void xlat_arch_tlbi_range(uintptr_t va, unsigned long long pages,
+				 int xlat_regime)
+{
+	unsigned int scale = 0U;
+
+	while (pages > 0U) {
+		unsigned long long num;
+
+		/* An odd number of pages can't be described by a range. */
+		if ((pages % 2U) != 0U) {
+			xlat_arch_tlbi_va_nodrain(va, xlat_regime);
+			va += PAGE_SIZE;
+			pages--;
+			continue;
+		}
+
+		/*
+		 * Invalidate the part of the range given by the bits of the
+		 * number of pages that this scale can describe.
+		 */
+		assert(scale <= 3U);
+		num = (pages >> ((5U * scale) + 1U)) & TLBI_RANGE_NUM_MASK;
+		if (num != 0U) {
+			uint64_t op = TLBI_RANGE_ADDR(va, scale, num - 1U);
+
+			if (xlat_regime == EL1_EL0_REGIME) {
+				tlbirvaae1is(op);
+			} else if (xlat_regime == EL2_REGIME) {
+				tlbirvae2is(op);
+			} else {
+				tlbirvae3is(op);
+			}
+
+			va += (uintptr_t)(TLBI_RANGE_PAGES(scale, num - 1U) <<
+					  PAGE_SIZE_SHIFT);
+			pages -= TLBI_RANGE_PAGES(scale, num - 1U);
+		}
+
+		scale++;
+	}
+}
+
+void xlat_arch_tlbi_va_range(uintptr_t va, size_t size, int xlat_regime)
+{
+	unsigned long long pages = size >> PAGE_SIZE_SHIFT;
+	bool range = is_tlbi_range_present();
+
+	assert((va & PAGE_SIZE_MASK) == 0U);
+	assert((size & PAGE_SIZE_MASK) == 0U);
+
+	/*
+	 * Ensure the translation table writes have drained into memory before
+	 * invalidating the TLB entries.
+	 */
+	dsbishst();
+
+	if (pages > (range ? XLAT_TLBI_RANGE_MAX_PAGES :
+			     PLAT_XLAT_TLBI_MAX_PAGES)) {
+		xlat_arch_tlbi_all(xlat_regime);
+	} else if (range) {
+		xlat_arch_tlbi_range(va, pages, xlat_regime);
+	} else {
+		for (; pages > 0U; pages--) {
+			xlat_arch_tlbi_va_nodrain(va, xlat_regime);
+			va += PAGE_SIZE;
+		}
+	}
+}
+
 void xlat_arch_tlbi_va_sync(void)
 {
 	/*
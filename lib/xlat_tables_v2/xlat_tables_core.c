@@ -6,6 +6,8 @@
 
 #include <arch_helpers.h>
 #include <assert.h>
+#include <boot_profile.h>
+#include <cdefs.h>
 #include <debug.h>
 #include <errno.h>
 #include <platform_def.h>
@@ -39,27 +41,47 @@ static inline void xlat_clean_dcache_range(uintptr_t addr, size_t size)
  */
 static int xlat_table_get_index(const xlat_ctx_t *ctx, const uint64_t *table)
 {
-	for (int i = 0; i < ctx->tables_num; i++)
-		if (ctx->tables[i] == table)
-			return i;
+	uintptr_t offset = (uintptr_t)table - (uintptr_t)ctx->tables;
+	uintptr_t idx = offset / sizeof(ctx->tables[0]);
 
 	/*
 	 * Maybe we were asked to get the index of the base level table, which
 	 * should never happen.
 	 */
-	assert(false);
+	assert((idx < (uintptr_t)ctx->tables_num) &&
+	       ((offset % sizeof(ctx->tables[0])) == 0U));
 
-	return -1;
+	return (int)idx;
+}
+
+/*
+ * Empty translation tables are kept in a list linked through their first
+ * entry, which holds the address of the next empty table. As tables are
+ * aligned to their size, this is an invalid descriptor.
+ */
+
+/* Adds a translation table that has no region mapped to the empty list. */
+static void xlat_table_put_empty(xlat_ctx_t *ctx, uint64_t *table)
+{
+	table[0] = (uint64_t)(uintptr_t)ctx->next_empty_table;
+	ctx->next_empty_table = table;
 }
 
 /* Returns a pointer to an empty translation table. */
-static uint64_t *xlat_table_get_empty(const xlat_ctx_t *ctx)
+static uint64_t *xlat_table_get_empty(xlat_ctx_t *ctx)
 {
-	for (int i = 0; i < ctx->tables_num; i++)
-		if (ctx->tables_mapped_regions[i] == 0)
-			return ctx->tables[i];
+	uint64_t *table = ctx->next_empty_table;
+
+	if (table == NULL)
+		return NULL;
+
+	assert(ctx->tables_mapped_regions[xlat_table_get_index(ctx, table)]
+	       == 0);
 
-	return NULL;
+	ctx->next_empty_table = (uint64_t *)(uintptr_t)table[0];
+	table[0] = INVALID_DESC;
+
+	return table;
 }
 
 /* Increments region count for a given table. */
@@ -71,13 +93,18 @@ static void xlat_table_inc_regions_count(const xlat_ctx_t *ctx,
 	ctx->tables_mapped_regions[idx]++;
 }
 
-/* Decrements region count for a given table. */
-static void xlat_table_dec_regions_count(const xlat_ctx_t *ctx,
-					 const uint64_t *table)
+/*
+ * Decrements region count for a given table. The table is given back to the
+ * empty list when no region is mapped in it any more.
+ */
+static void xlat_table_dec_regions_count(xlat_ctx_t *ctx, uint64_t *table)
 {
 	int idx = xlat_table_get_index(ctx, table);
 
 	ctx->tables_mapped_regions[idx]--;
+
+	if (ctx->tables_mapped_regions[idx] == 0)
+		xlat_table_put_empty(ctx, table);
 }
 
 /* Returns 0 if the specified table isn't empty, otherwise 1. */
@@ -233,7 +260,7 @@ typedef enum {
 
 /*
  * Recursive function that writes to the translation tables and unmaps the
- * specified region.
+ * specified region. The caller must invalidate the TLB entries of the region.
  */
 static void xlat_tables_unmap_region(xlat_ctx_t *ctx, mmap_region_t *mm,
 				     const uintptr_t table_base_va,
@@ -327,7 +354,6 @@ static void xlat_tables_unmap_region(xlat_ctx_t *ctx, mmap_region_t *mm,
 		if (action == ACTION_WRITE_BLOCK_ENTRY) {
 
 			table_base[table_idx] = INVALID_DESC;
-			xlat_arch_tlbi_va(table_idx_va, ctx->xlat_regime);
 
 		} else if (action == ACTION_RECURSE_INTO_TABLE) {
 
@@ -344,11 +370,8 @@ static void xlat_tables_unmap_region(xlat_ctx_t *ctx, mmap_region_t *mm,
 			/*
 			 * If the subtable is now empty, remove its reference.
 			 */
-			if (xlat_table_is_empty(ctx, subtable)) {
+			if (xlat_table_is_empty(ctx, subtable))
 				table_base[table_idx] = INVALID_DESC;
-				xlat_arch_tlbi_va(table_idx_va,
-						  ctx->xlat_regime);
-			}
 
 		} else {
 			assert(action == ACTION_NONE);
@@ -726,6 +749,7 @@ void mmap_add_region_ctx(xlat_ctx_t *ctx, const mmap_region_t *mm)
 	const mmap_region_t *mm_last;
 	unsigned long long end_pa = mm->base_pa + mm->size - 1U;
 	uintptr_t end_va = mm->base_va + mm->size - 1U;
+	uint64_t start __unused;
 	int ret;
 
 	/* Ignore empty regions */
@@ -735,6 +759,8 @@ void mmap_add_region_ctx(xlat_ctx_t *ctx, const mmap_region_t *mm)
 	/* Static regions must be added before initializing the xlat tables. */
 	assert(!ctx->initialized);
 
+	BOOT_PROF_START(start);
+
 	ret = mmap_add_region_check(ctx, mm);
 	if (ret != 0) {
 		ERROR("mmap_add_region_check() failed. error %d\n", ret);
@@ -809,6 +835,8 @@ void mmap_add_region_ctx(xlat_ctx_t *ctx, const mmap_region_t *mm)
 		ctx->max_pa = end_pa;
 	if (end_va > ctx->max_va)
 		ctx->max_va = end_va;
+
+	BOOT_PROF_END(BOOT_PROF_XLAT_MAP, start, 0U);
 }
 
 void mmap_add_ctx(xlat_ctx_t *ctx, const mmap_region_t *mm)
@@ -980,6 +1008,13 @@ int mmap_remove_dynamic_region_ctx(xlat_ctx_t *ctx, uintptr_t base_va,
 		xlat_clean_dcache_range((uintptr_t)ctx->base_table,
 			ctx->base_table_entries * sizeof(uint64_t));
 #endif
+		/*
+		 * This also invalidates the cached walks through the sub-tables
+		 * that have been unlinked, as they were used to translate
+		 * addresses of the region.
+		 */
+		xlat_arch_tlbi_va_range(mm->base_va, mm->size,
+					ctx->xlat_regime);
 		xlat_arch_tlbi_va_sync();
 	}
 
@@ -1012,8 +1047,199 @@ int mmap_remove_dynamic_region_ctx(xlat_ctx_t *ctx, uintptr_t base_va,
 
 #endif /* PLAT_XLAT_TABLES_DYNAMIC */
 
+#if XLAT_TABLES_COALESCE
+
+/* Descriptor bits that hold the output address or the Contiguous bit. */
+#define XLAT_COALESCE_OA_MASK	(TABLE_ADDR_MASK | UPPER_ATTRS(CONT_HINT))
+
+/* Returns true if the descriptor is a block or page descriptor. */
+static bool xlat_desc_is_leaf(uint64_t desc, unsigned int level)
+{
+	if (level == XLAT_TABLE_LEVEL_MAX)
+		return (desc & DESC_MASK) == PAGE_DESC;
+
+	return (level >= MIN_LVL_BLOCK_DESC) &&
+	       ((desc & DESC_MASK) == BLOCK_DESC);
+}
+
+/*
+ * Returns true if the 'count' entries starting at 'entries' are block or page
+ * descriptors with the same attributes that map a physically contiguous range
+ * aligned to its own size.
+ */
+static bool xlat_entries_are_mergeable(const uint64_t *entries,
+				       unsigned int count, unsigned int level)
+{
+	unsigned long long block_size = XLAT_BLOCK_SIZE(level);
+	unsigned long long pa = entries[0] & TABLE_ADDR_MASK;
+	uint64_t attr = entries[0] & ~XLAT_COALESCE_OA_MASK;
+
+	if ((pa & ((block_size * count) - 1U)) != 0U)
+		return false;
+
+	for (unsigned int i = 0U; i < count; i++) {
+		uint64_t desc = entries[i];
+
+		if (!xlat_desc_is_leaf(desc, level) ||
+		    ((desc & ~XLAT_COALESCE_OA_MASK) != attr) ||
+		    ((desc & TABLE_ADDR_MASK) != (pa + (i * block_size))))
+			return false;
+	}
+
+	return true;
+}
+
+/*
+ * Returns true if the VA range can be mapped with entries of 'block_size'
+ * bytes that are never split afterwards. This excludes the ranges that
+ * overlap a dynamic region, which can be unmapped later, and the ranges of
+ * regions that require a finer granularity.
+ */
+static bool xlat_range_can_coalesce(const xlat_ctx_t *ctx, uintptr_t base_va,
+				    size_t size, size_t block_size)
+{
+	uintptr_t end_va = base_va + size - 1U;
+
+	for (const mmap_region_t *mm = ctx->mmap; mm->size != 0U; mm++) {
+		if ((mm->base_va > end_va) ||
+		    ((mm->base_va + mm->size - 1U) < base_va))
+			continue;
+#if PLAT_XLAT_TABLES_DYNAMIC
+		if ((mm->attr & MT_DYNAMIC) != 0U)
+			return false;
+#endif
+		if (mm->granularity < block_size)
+			return false;
+	}
+
+	return true;
+}
+
+/*
+ * Recursive function that replaces the subtables that map a single block of
+ * their parent level with a block descriptor, then sets the Contiguous bit on
+ * the aligned runs of XLAT_CONTIG_ENTRIES mergeable entries. This reduces the
+ * number of TLB entries needed to cover the mapped regions.
+ */
+static void xlat_tables_coalesce(xlat_ctx_t *ctx, uintptr_t table_base_va,
+				 uint64_t *table_base, unsigned int table_entries,
+				 unsigned int level)
+{
+	size_t block_size = XLAT_BLOCK_SIZE(level);
+
+	for (unsigned int i = 0U; i < table_entries; i++) {
+		uintptr_t va = table_base_va + (i * block_size);
+		uint64_t desc = table_base[i];
+		uint64_t *subtable;
+
+		if ((level == XLAT_TABLE_LEVEL_MAX) ||
+		    ((desc & DESC_MASK) != TABLE_DESC))
+			continue;
+
+		subtable = (uint64_t *)(uintptr_t)(desc & TABLE_ADDR_MASK);
+		xlat_tables_coalesce(ctx, va, subtable, XLAT_TABLE_ENTRIES,
+				     level + 1U);
+
+		if ((level < MIN_LVL_BLOCK_DESC) ||
+		    !xlat_entries_are_mergeable(subtable, XLAT_TABLE_ENTRIES,
+						level + 1U) ||
+		    !xlat_range_can_coalesce(ctx, va, block_size, block_size))
+			continue;
+
+		table_base[i] = (subtable[0] &
+				 ~(XLAT_COALESCE_OA_MASK | DESC_MASK)) |
+				(subtable[0] & TABLE_ADDR_MASK) | BLOCK_DESC;
+
+#if PLAT_XLAT_TABLES_DYNAMIC
+		/* Give the subtable back to the list of empty tables. */
+		for (unsigned int j = 0U; j < XLAT_TABLE_ENTRIES; j++)
+			subtable[j] = INVALID_DESC;
+		ctx->tables_mapped_regions[xlat_table_get_index(ctx, subtable)] = 0;
+		xlat_table_put_empty(ctx, subtable);
+#endif
+	}
+
+	for (unsigned int i = 0U; (i + XLAT_CONTIG_ENTRIES) <= table_entries;
+	     i += XLAT_CONTIG_ENTRIES) {
+		uintptr_t va = table_base_va + (i * block_size);
+
+		if (!xlat_entries_are_mergeable(&table_base[i],
+						XLAT_CONTIG_ENTRIES, level) ||
+		    !xlat_range_can_coalesce(ctx, va,
+					     XLAT_CONTIG_ENTRIES * block_size,
+					     block_size))
+			continue;
+
+		for (unsigned int j = 0U; j < XLAT_CONTIG_ENTRIES; j++)
+			table_base[i + j] |= UPPER_ATTRS(CONT_HINT);
+	}
+}
+
+#if LOG_LEVEL >= LOG_LEVEL_VERBOSE
+/*
+ * Counts the translation tables reachable from 'table_base' and estimates the
+ * number of TLB entries needed to cover the mapped regions, counting a run of
+ * entries with the Contiguous bit set as a single one.
+ */
+static void xlat_tables_count(const uint64_t *table_base,
+			      unsigned int table_entries, unsigned int level,
+			      unsigned int *tables, unsigned int *tlb_entries)
+{
+	for (unsigned int i = 0U; i < table_entries; i++) {
+		uint64_t desc = table_base[i];
+
+		if (xlat_desc_is_leaf(desc, level)) {
+			if (((desc & UPPER_ATTRS(CONT_HINT)) == 0U) ||
+			    ((i % XLAT_CONTIG_ENTRIES) == 0U))
+				(*tlb_entries)++;
+		} else if ((level < XLAT_TABLE_LEVEL_MAX) &&
+			   ((desc & DESC_MASK) == TABLE_DESC)) {
+			(*tables)++;
+			xlat_tables_count(
+				(uint64_t *)(uintptr_t)(desc & TABLE_ADDR_MASK),
+				XLAT_TABLE_ENTRIES, level + 1U, tables,
+				tlb_entries);
+		}
+	}
+}
+#endif /* LOG_LEVEL >= LOG_LEVEL_VERBOSE */
+
+static void xlat_tables_coalesce_ctx(xlat_ctx_t *ctx)
+{
+#if LOG_LEVEL >= LOG_LEVEL_VERBOSE
+	unsigned int tables_before = 0U, tlb_entries_before = 0U;
+	unsigned int tables_after = 0U, tlb_entries_after = 0U;
+
+	xlat_tables_count(ctx->base_table, ctx->base_table_entries,
+			  ctx->base_level, &tables_before, &tlb_entries_before);
+#endif
+
+	xlat_tables_coalesce(ctx, 0U, ctx->base_table, ctx->base_table_entries,
+			     ctx->base_level);
+
+#if !(HW_ASSISTED_COHERENCY || WARMBOOT_ENABLE_DCACHE_EARLY)
+	xlat_clean_dcache_range((uintptr_t)ctx->base_table,
+			   ctx->base_table_entries * sizeof(uint64_t));
+	xlat_clean_dcache_range((uintptr_t)ctx->tables,
+			   (size_t)ctx->tables_num * sizeof(ctx->tables[0]));
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_VERBOSE
+	xlat_tables_count(ctx->base_table, ctx->base_table_entries,
+			  ctx->base_level, &tables_after, &tlb_entries_after);
+	VERBOSE("Coalesced translation tables:\n");
+	VERBOSE("  Sub-tables in use: %u -> %u\n", tables_before, tables_after);
+	VERBOSE("  Estimated TLB entries: %u -> %u\n", tlb_entries_before,
+		tlb_entries_after);
+#endif
+}
+
+#endif /* XLAT_TABLES_COALESCE */
+
 void init_xlat_tables_ctx(xlat_ctx_t *ctx)
 {
+	uint64_t start __unused;
+
 	assert(ctx != NULL);
 	assert(!ctx->initialized);
 	assert((ctx->xlat_regime == EL3_REGIME) ||
@@ -1021,6 +1247,8 @@ void init_xlat_tables_ctx(xlat_ctx_t *ctx)
 	       (ctx->xlat_regime == EL1_EL0_REGIME));
 	assert(!is_mmu_enabled_ctx(ctx));
 
+	BOOT_PROF_START(start);
+
 	mmap_region_t *mm = ctx->mmap;
 
 	xlat_mmap_print(mm);
@@ -1038,6 +1266,13 @@ void init_xlat_tables_ctx(xlat_ctx_t *ctx)
 			ctx->tables[j][i] = INVALID_DESC;
 	}
 
+#if PLAT_XLAT_TABLES_DYNAMIC
+	/* Hand out the tables in the order of the array. */
+	ctx->next_empty_table = NULL;
+	for (int j = ctx->tables_num - 1; j >= 0; j--)
+		xlat_table_put_empty(ctx, ctx->tables[j]);
+#endif
+
 	while (mm->size != 0U) {
 		uintptr_t end_va = xlat_tables_map_region(ctx, mm, 0U,
 				ctx->base_table, ctx->base_table_entries,
@@ -1060,7 +1295,13 @@ void init_xlat_tables_ctx(xlat_ctx_t *ctx)
 	assert(ctx->max_va <= ctx->va_max_address);
 	assert(ctx->max_pa <= ctx->pa_max_address);
 
+#if XLAT_TABLES_COALESCE
+	xlat_tables_coalesce_ctx(ctx);
+#endif
+
 	ctx->initialized = true;
 
+	BOOT_PROF_END(BOOT_PROF_XLAT_INIT, start, 0U);
+
 	xlat_tables_print(ctx);
 }
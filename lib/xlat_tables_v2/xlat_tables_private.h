@@ -36,6 +36,14 @@
 
 #endif /* PLAT_XLAT_TABLES_DYNAMIC */
 
+#if XLAT_TABLES_COALESCE
+/*
+ * Number of adjacent entries described by a single TLB entry when all of them
+ * have the Contiguous bit set, with a 4KB translation granule.
+ */
+#define XLAT_CONTIG_ENTRIES	U(16)
+#endif
+
 extern uint64_t mmu_cfg_params[MMU_CFG_PARAM_MAX];
 
 /*
@@ -58,8 +66,24 @@ uint64_t xlat_arch_regime_get_xn_desc(int xlat_regime);
 void xlat_arch_tlbi_va(uintptr_t va, int xlat_regime);
 
 /*
- * This function has to be called at the end of any code that uses the function
- * xlat_arch_tlbi_va().
+ * Number of pages above which xlat_arch_tlbi_va_range() invalidates all the
+ * TLB entries of the translation regime when it can't use TLBI range
+ * instructions.
+ */
+#ifndef PLAT_XLAT_TLBI_MAX_PAGES
+#define PLAT_XLAT_TLBI_MAX_PAGES	U(64)
+#endif
+
+/*
+ * Invalidate all TLB entries that match any page-aligned virtual address in
+ * the range [va, va + size) in the same way as xlat_arch_tlbi_va(). The range
+ * instructions are used if the PE implements them.
+ */
+void xlat_arch_tlbi_va_range(uintptr_t va, size_t size, int xlat_regime);
+
+/*
+ * This function has to be called at the end of any code that uses the
+ * functions xlat_arch_tlbi_va() or xlat_arch_tlbi_va_range().
  */
 void xlat_arch_tlbi_va_sync(void);
 
@@ -418,6 +418,41 @@ int xlat_get_mem_attributes_ctx(const xlat_ctx_t *ctx, uintptr_t base_va,
 }
 
 
+#if XLAT_TABLES_COALESCE
+/*
+ * Clears the Contiguous bit from the run of page descriptors that contains
+ * 'entry', which maps 'base_va'. All the entries of the run must be rewritten
+ * with break-before-make, as the TLBs can hold a single translation for the
+ * whole run.
+ */
+static void xlat_clear_contig_run(const xlat_ctx_t *ctx, uint64_t *entry,
+				  uintptr_t base_va)
+{
+	size_t run_size = XLAT_CONTIG_ENTRIES * sizeof(uint64_t);
+	uint64_t *run = (uint64_t *)((uintptr_t)entry & ~(run_size - 1U));
+	uintptr_t run_va = base_va & ~((XLAT_CONTIG_ENTRIES * PAGE_SIZE) - 1U);
+	uint64_t descs[XLAT_CONTIG_ENTRIES];
+
+	for (unsigned int i = 0U; i < XLAT_CONTIG_ENTRIES; i++) {
+		descs[i] = run[i] & ~UPPER_ATTRS(CONT_HINT);
+		run[i] = INVALID_DESC;
+	}
+#if !(HW_ASSISTED_COHERENCY || WARMBOOT_ENABLE_DCACHE_EARLY)
+	clean_dcache_range((uintptr_t)run, run_size);
+#endif
+	for (unsigned int i = 0U; i < XLAT_CONTIG_ENTRIES; i++)
+		xlat_arch_tlbi_va(run_va + (i * PAGE_SIZE), ctx->xlat_regime);
+
+	xlat_arch_tlbi_va_sync();
+
+	for (unsigned int i = 0U; i < XLAT_CONTIG_ENTRIES; i++)
+		run[i] = descs[i];
+#if !(HW_ASSISTED_COHERENCY || WARMBOOT_ENABLE_DCACHE_EARLY)
+	clean_dcache_range((uintptr_t)run, run_size);
+#endif
+}
+#endif /* XLAT_TABLES_COALESCE */
+
 int xlat_change_mem_attributes_ctx(const xlat_ctx_t *ctx, uintptr_t base_va,
 				   size_t size, uint32_t attr)
 {
@@ -511,52 +546,96 @@ int xlat_change_mem_attributes_ctx(const xlat_ctx_t *ctx, uintptr_t base_va,
 	/* Restore original value. */
 	base_va = base_va_original;
 
-	for (unsigned int i = 0U; i < pages_count; ++i) {
-
-		uint32_t old_attr = 0U, new_attr;
-		uint64_t *entry = NULL;
-		unsigned int level = 0U;
-		unsigned long long addr_pa = 0ULL;
-
-		(void) xlat_get_mem_attributes_internal(ctx, base_va, &old_attr,
-					    &entry, &addr_pa, &level);
+	for (size_t i = 0U; i < pages_count; ) {
+		uintptr_t chunk_va = base_va;
+		uint64_t *entries = NULL;
+		unsigned int chunk_pages;
 
 		/*
-		 * From attr, only MT_RO/MT_RW, MT_EXECUTE/MT_EXECUTE_NEVER and
-		 * MT_USER/MT_PRIVILEGED are taken into account. Any other
-		 * information is ignored.
+		 * Update at once the pages whose descriptors are in the same
+		 * translation table, so that their TLB entries can be
+		 * invalidated as a range.
 		 */
+		chunk_pages = XLAT_TABLE_ENTRIES - (unsigned int)
+			XLAT_TABLE_IDX(base_va, XLAT_TABLE_LEVEL_MAX);
+		if (chunk_pages > (pages_count - i))
+			chunk_pages = pages_count - i;
 
-		/* Clean the old attributes so that they can be rebuilt. */
-		new_attr = old_attr & ~(MT_RW | MT_EXECUTE_NEVER | MT_USER);
+		for (unsigned int j = 0U; j < chunk_pages; j++) {
+			uint32_t old_attr = 0U, new_attr;
+			uint64_t *entry = NULL;
+			unsigned int level = 0U;
+			unsigned long long addr_pa = 0ULL;
 
-		/*
-		 * Update attributes, but filter out the ones this function
-		 * isn't allowed to change.
-		 */
-		new_attr |= attr & (MT_RW | MT_EXECUTE_NEVER | MT_USER);
+			(void) xlat_get_mem_attributes_internal(ctx, base_va,
+					&old_attr, &entry, &addr_pa, &level);
+
+			if (j == 0U)
+				entries = entry;
+			assert(entry == &entries[j]);
+
+			/*
+			 * From attr, only MT_RO/MT_RW,
+			 * MT_EXECUTE/MT_EXECUTE_NEVER and MT_USER/MT_PRIVILEGED
+			 * are taken into account. Any other information is
+			 * ignored.
+			 */
+
+			/*
+			 * Clean the old attributes so that they can be
+			 * rebuilt.
+			 */
+			new_attr = old_attr &
+				   ~(MT_RW | MT_EXECUTE_NEVER | MT_USER);
+
+			/*
+			 * Update attributes, but filter out the ones this
+			 * function isn't allowed to change.
+			 */
+			new_attr |= attr & (MT_RW | MT_EXECUTE_NEVER | MT_USER);
+
+#if XLAT_TABLES_COALESCE
+			/*
+			 * The run of pages that includes this one can't stay
+			 * merged.
+			 */
+			if ((*entry & UPPER_ATTRS(CONT_HINT)) != 0U)
+				xlat_clear_contig_run(ctx, entry, base_va);
+#endif
+
+			/*
+			 * The break-before-make sequence requires writing an
+			 * invalid descriptor and making sure that the system
+			 * sees the change before writing the new descriptor.
+			 * The new descriptor is written without its type bits,
+			 * which keeps it invalid until they are set after the
+			 * TLB invalidation.
+			 */
+			*entry = xlat_desc(ctx, new_attr, addr_pa, level) &
+				 ~DESC_MASK;
+
+			base_va += PAGE_SIZE;
+		}
 
-		/*
-		 * The break-before-make sequence requires writing an invalid
-		 * descriptor and making sure that the system sees the change
-		 * before writing the new descriptor.
-		 */
-		*entry = INVALID_DESC;
 #if !(HW_ASSISTED_COHERENCY || WARMBOOT_ENABLE_DCACHE_EARLY)
-		dccvac((uintptr_t)entry);
+		clean_dcache_range((uintptr_t)entries,
+				   chunk_pages * sizeof(uint64_t));
 #endif
-		/* Invalidate any cached copy of this mapping in the TLBs. */
-		xlat_arch_tlbi_va(base_va, ctx->xlat_regime);
+		/* Invalidate any cached copy of these mappings in the TLBs. */
+		xlat_arch_tlbi_va_range(chunk_va, chunk_pages * PAGE_SIZE,
+					ctx->xlat_regime);
 
 		/* Ensure completion of the invalidation. */
 		xlat_arch_tlbi_va_sync();
 
-		/* Write new descriptor */
-		*entry = xlat_desc(ctx, new_attr, addr_pa, level);
+		/* Make the new descriptors valid. */
+		for (unsigned int j = 0U; j < chunk_pages; j++)
+			entries[j] |= PAGE_DESC;
 #if !(HW_ASSISTED_COHERENCY || WARMBOOT_ENABLE_DCACHE_EARLY)
-		dccvac((uintptr_t)entry);
+		clean_dcache_range((uintptr_t)entries,
+				   chunk_pages * sizeof(uint64_t));
 #endif
-		base_va += PAGE_SIZE;
+		i += chunk_pages;
 	}
 
 	/* Ensure that the last descriptor writen is seen by the system. */
@@ -47,55 +47,137 @@ static void ZLIB_INTERNAL zfree(void *opaque, void *ptr)
 }
 
 /*
- * gunzip - decompress gzip data
- * @in_buf: source of compressed input. Upon exit, the end of input.
- * @in_len: length of in_buf
- * @out_buf: destination of decompressed output. Upon exit, the end of output.
+ * State of the decompression started by gunzip_stream_start(). gz_stream_ret is
+ * 1 once the end of the compressed stream has been reached, and a negative
+ * error code if the decompression has failed.
+ */
+static z_stream gz_stream;
+static int gz_stream_ret;
+
+/*
+ * gunzip_stream_start - start decompressing gzip data passed in chunks
+ * @out_buf: destination of decompressed output
  * @out_len: length of out_buf
  * @work_buf: workspace
  * @work_len: length of workspace
  */
-int gunzip(uintptr_t *in_buf, size_t in_len, uintptr_t *out_buf,
-	   size_t out_len, uintptr_t work_buf, size_t work_len)
+int gunzip_stream_start(uintptr_t out_buf, size_t out_len,
+			uintptr_t work_buf, size_t work_len)
 {
-	z_stream stream;
-	int zret, ret;
+	int zret;
 
 	zalloc_start = work_buf;
 	zalloc_end = work_buf + work_len;
 	zalloc_current = zalloc_start;
 
-	stream.next_in = (typeof(stream.next_in))*in_buf;
-	stream.avail_in = in_len;
-	stream.next_out = (typeof(stream.next_out))*out_buf;
-	stream.avail_out = out_len;
-	stream.zalloc = zcalloc;
-	stream.zfree = zfree;
-	stream.opaque = (voidpf)0;
+	memset(&gz_stream, 0, sizeof(gz_stream));
+	gz_stream.next_out = (typeof(gz_stream.next_out))out_buf;
+	gz_stream.avail_out = out_len;
+	gz_stream.zalloc = zcalloc;
+	gz_stream.zfree = zfree;
+	gz_stream.opaque = (voidpf)0;
+	gz_stream_ret = 0;
 
-	zret = inflateInit(&stream);
+	zret = inflateInit(&gz_stream);
 	if (zret != Z_OK) {
 		ERROR("zlib: inflate init failed (ret = %d)\n", zret);
 		return (zret == Z_MEM_ERROR) ? -ENOMEM : -EIO;
 	}
 
-	zret = inflate(&stream, Z_NO_FLUSH);
+	return 0;
+}
+
+/*
+ * gunzip_stream_update - decompress the next chunk of gzip data
+ * @in_buf: next chunk of compressed input
+ * @in_len: length of in_buf
+ *
+ * Any data following the end of the compressed stream is ignored.
+ */
+int gunzip_stream_update(uintptr_t in_buf, size_t in_len)
+{
+	int zret;
+
+	if (gz_stream_ret < 0)
+		return gz_stream_ret;
+
+	if ((gz_stream_ret != 0) || (in_len == 0))
+		return 0;
+
+	gz_stream.next_in = (typeof(gz_stream.next_in))in_buf;
+	gz_stream.avail_in = in_len;
+
+	zret = inflate(&gz_stream, Z_NO_FLUSH);
 	if (zret == Z_STREAM_END) {
-		ret = 0;
-	} else {
-		if (stream.msg)
-			ERROR("%s\n", stream.msg);
-		ERROR("zlib: inflate failed (ret = %d)\n", zret);
-		ret = (zret == Z_MEM_ERROR) ? -ENOMEM : -EIO;
+		gz_stream_ret = 1;
+		return 0;
+	}
+
+	if (zret == Z_OK) {
+		if (gz_stream.avail_in == 0)
+			return 0;
+
+		/* Input left over means that the output buffer is full */
+		ERROR("zlib: output buffer too small\n");
+		gz_stream_ret = -EIO;
+		return gz_stream_ret;
+	}
+
+	if (gz_stream.msg)
+		ERROR("%s\n", gz_stream.msg);
+	ERROR("zlib: inflate failed (ret = %d)\n", zret);
+	gz_stream_ret = (zret == Z_MEM_ERROR) ? -ENOMEM : -EIO;
+
+	return gz_stream_ret;
+}
+
+/*
+ * gunzip_stream_finish - finish decompressing gzip data
+ * @out_buf: upon exit, the end of output
+ *
+ * Returns an error if the end of the compressed stream has not been reached.
+ */
+int gunzip_stream_finish(uintptr_t *out_buf)
+{
+	int ret = 0;
+
+	if (gz_stream_ret < 0) {
+		ret = gz_stream_ret;
+	} else if (gz_stream_ret == 0) {
+		ERROR("zlib: truncated input\n");
+		ret = -EIO;
 	}
 
-	VERBOSE("zlib: %lu byte input\n", stream.total_in);
-	VERBOSE("zlib: %lu byte output\n", stream.total_out);
+	VERBOSE("zlib: %lu byte input\n", gz_stream.total_in);
+	VERBOSE("zlib: %lu byte output\n", gz_stream.total_out);
 
-	*in_buf = (uintptr_t)stream.next_in;
-	*out_buf = (uintptr_t)stream.next_out;
+	*out_buf = (uintptr_t)gz_stream.next_out;
 
-	inflateEnd(&stream);
+	inflateEnd(&gz_stream);
 
 	return ret;
 }
+
+/*
+ * gunzip - decompress gzip data
+ * @in_buf: source of compressed input. Upon exit, the end of input.
+ * @in_len: length of in_buf
+ * @out_buf: destination of decompressed output. Upon exit, the end of output.
+ * @out_len: length of out_buf
+ * @work_buf: workspace
+ * @work_len: length of workspace
+ */
+int gunzip(uintptr_t *in_buf, size_t in_len, uintptr_t *out_buf,
+	   size_t out_len, uintptr_t work_buf, size_t work_len)
+{
+	int ret;
+
+	ret = gunzip_stream_start(*out_buf, out_len, work_buf, work_len);
+	if (ret != 0)
+		return ret;
+
+	gunzip_stream_update(*in_buf, in_len);
+	*in_buf = (uintptr_t)gz_stream.next_in;
+
+	return gunzip_stream_finish(out_buf);
+}
@@ -0,0 +1,326 @@
+/*
+ * Copyright (c) 2018, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "zutil.h"
+#include "inftrees.h"
+#include "inflate.h"
+#include "inffast.h"
+
+/*
+ * Replacement of inflate_fast() from inffast.c for 64-bit platforms. It has the
+ * same entry assumptions and leaves the stream in the same state, so inflate()
+ * and gunzip() are unaffected. It differs from the stock implementation in the
+ * following ways:
+ *
+ *  - The bit buffer is 64 bits wide and, while at least 8 bytes of input are
+ *    left, it is refilled once per length/distance pair with a single 8-byte
+ *    load. The stock code refills it byte per byte up to four times per pair.
+ *
+ *  - Consecutive literals are decoded from the bits already in the buffer
+ *    until one of them is not in the first-level table or its code is longer
+ *    than the bits left.
+ *
+ *  - Long matches are copied with memcpy() or memset(). Matches that overlap
+ *    the bytes they produce are copied in chunks of the match distance, which
+ *    doubles after each chunk.
+ *
+ * Unaligned accesses may fault, even with the MMU enabled, so the input is
+ * read with aligned 8-byte loads only.
+ */
+
+#if __BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__
+#error "tf_inffast.c only supports little-endian platforms"
+#endif
+
+/* Matches shorter than this are copied byte per byte */
+#define INFLATE_FAST_MIN_MEMCPY		16U
+
+typedef uint64_t __attribute__((__may_alias__)) inflate_word_t;
+
+/*
+ * Return the 8 bytes at 'p' as a little-endian word. The word is built from the
+ * aligned words that contain these bytes, so no memory beyond the aligned word
+ * of p[7] is read.
+ */
+static inline uint64_t load_le64(const unsigned char *p)
+{
+	const inflate_word_t *w = (const inflate_word_t *)
+					((uintptr_t)p & ~(uintptr_t)7U);
+	unsigned int shift = ((unsigned int)(uintptr_t)p & 7U) * 8U;
+
+	if (shift == 0U)
+		return w[0];
+
+	return (w[0] >> shift) | (w[1] << (64U - shift));
+}
+
+/*
+ * Copy a match of 'len' bytes, 'len' >= 3, from 'dist' bytes back in the
+ * output. Return the updated output pointer.
+ */
+static inline unsigned char *copy_match(unsigned char *out, unsigned int dist,
+					unsigned int len)
+{
+	const unsigned char *from = out - dist;
+
+	if (len < INFLATE_FAST_MIN_MEMCPY) {
+		do {
+			*out++ = *from++;
+		} while (--len != 0U);
+
+		return out;
+	}
+
+	if (dist == 1U) {
+		memset(out, *from, len);
+		return out + len;
+	}
+
+	/*
+	 * After each chunk, the bytes from 'from' to 'out' hold a whole number
+	 * of repetitions of the pattern, so twice as many can be copied at once.
+	 */
+	while (dist < len) {
+		memcpy(out, from, dist);
+		out += dist;
+		len -= dist;
+		dist += dist;
+	}
+	memcpy(out, from, len);
+
+	return out + len;
+}
+
+void ZLIB_INTERNAL inflate_fast(z_streamp strm, unsigned start)
+{
+	struct inflate_state *state;
+	z_const unsigned char *in;	/* local strm->next_in */
+	z_const unsigned char *last;	/* have at least 6 bytes while in < last */
+	z_const unsigned char *wlast;	/* have at least 8 bytes while in < wlast */
+	unsigned char *out;		/* local strm->next_out */
+	unsigned char *beg;		/* inflate()'s initial strm->next_out */
+	unsigned char *end;		/* while out < end, enough space available */
+#ifdef INFLATE_STRICT
+	unsigned int dmax;		/* maximum distance from zlib header */
+#endif
+	unsigned int wsize;		/* window size or zero if not using window */
+	unsigned int whave;		/* valid bytes in the window */
+	unsigned int wnext;		/* window write index */
+	unsigned char *window;		/* allocated sliding window */
+	uint64_t hold;			/* local strm->hold */
+	unsigned int bits;		/* valid bits in hold */
+	code const *lcode;		/* local strm->lencode */
+	code const *dcode;		/* local strm->distcode */
+	unsigned int lmask;		/* mask for first level of length codes */
+	unsigned int dmask;		/* mask for first level of distance codes */
+	code here;			/* retrieved table entry */
+	unsigned int op;		/* code bits, operation, extra bits, or */
+					/*  window position, window bytes to copy */
+	unsigned int len;		/* match length, unused bytes */
+	unsigned int dist;		/* match distance */
+	unsigned char *from;		/* where to copy match from */
+
+	/* copy state to local variables */
+	state = (struct inflate_state *)strm->state;
+	in = strm->next_in;
+	last = in + (strm->avail_in - 5U);
+	wlast = (strm->avail_in >= 8U) ? (in + (strm->avail_in - 7U)) : in;
+	out = strm->next_out;
+	beg = out - (start - strm->avail_out);
+	end = out + (strm->avail_out - 257U);
+#ifdef INFLATE_STRICT
+	dmax = state->dmax;
+#endif
+	wsize = state->wsize;
+	whave = state->whave;
+	wnext = state->wnext;
+	window = state->window;
+	hold = state->hold;
+	bits = state->bits;
+	lcode = state->lencode;
+	dcode = state->distcode;
+	lmask = (1U << state->lenbits) - 1U;
+	dmask = (1U << state->distbits) - 1U;
+
+	/*
+	 * Decode literals and length/distances until end-of-block or not enough
+	 * input data or output space. The bits of 'hold' above 'bits' are either
+	 * zero or a copy of the next input bytes, so they can be ORed again with
+	 * the same bytes. A length/distance pair uses at most 48 bits.
+	 */
+	do {
+		if (in < wlast) {
+			hold |= load_le64(in) << bits;
+			in += (63U - bits) >> 3;
+			bits |= 56U;
+		} else {
+			while (bits < 48U) {
+				hold |= (uint64_t)(*in++) << bits;
+				bits += 8U;
+			}
+		}
+
+		here = lcode[hold & lmask];
+		if (here.op == 0U) {
+			do {
+				Tracevv((stderr, here.val >= 0x20 && here.val < 0x7f ?
+					"inflate:         literal '%c'\n" :
+					"inflate:         literal 0x%02x\n",
+					here.val));
+				hold >>= here.bits;
+				bits -= here.bits;
+				*out++ = (unsigned char)(here.val);
+				here = lcode[hold & lmask];
+			} while ((here.op == 0U) && (here.bits <= bits));
+			continue;
+		}
+	dolen:
+		op = (unsigned int)(here.bits);
+		hold >>= op;
+		bits -= op;
+		op = (unsigned int)(here.op);
+		if (op == 0U) {				/* literal */
+			Tracevv((stderr, here.val >= 0x20 && here.val < 0x7f ?
+				"inflate:         literal '%c'\n" :
+				"inflate:         literal 0x%02x\n", here.val));
+			*out++ = (unsigned char)(here.val);
+		} else if ((op & 16U) != 0U) {		/* length base */
+			len = (unsigned int)(here.val);
+			op &= 15U;			/* number of extra bits */
+			len += (unsigned int)hold & ((1U << op) - 1U);
+			hold >>= op;
+			bits -= op;
+			Tracevv((stderr, "inflate:         length %u\n", len));
+			here = dcode[hold & dmask];
+	dodist:
+			op = (unsigned int)(here.bits);
+			hold >>= op;
+			bits -= op;
+			op = (unsigned int)(here.op);
+			if ((op & 16U) != 0U) {		/* distance base */
+				dist = (unsigned int)(here.val);
+				op &= 15U;		/* number of extra bits */
+				dist += (unsigned int)hold & ((1U << op) - 1U);
+#ifdef INFLATE_STRICT
+				if (dist > dmax) {
+					strm->msg =
+					  (char *)"invalid distance too far back";
+					state->mode = BAD;
+					break;
+				}
+#endif
+				hold >>= op;
+				bits -= op;
+				Tracevv((stderr, "inflate:         distance %u\n",
+					 dist));
+				op = (unsigned int)(out - beg);	/* max distance */
+				if (dist <= op) {	/* copy direct from output */
+					out = copy_match(out, dist, len);
+					continue;
+				}
+
+				/* copy from window */
+				op = dist - op;		/* distance back in window */
+				if ((op > whave) && (state->sane != 0)) {
+					strm->msg =
+					  (char *)"invalid distance too far back";
+					state->mode = BAD;
+					break;
+				}
+				from = window;
+				if (wnext == 0U) {	/* very common case */
+					from += wsize - op;
+					if (op < len) {	/* some from window */
+						len -= op;
+						do {
+							*out++ = *from++;
+						} while (--op != 0U);
+						from = out - dist;
+					}
+				} else if (wnext < op) {	/* wrap around */
+					from += wsize + wnext - op;
+					op -= wnext;
+					if (op < len) {	/* some from end of window */
+						len -= op;
+						do {
+							*out++ = *from++;
+						} while (--op != 0U);
+						from = window;
+						if (wnext < len) {
+							/* some from start of window */
+							op = wnext;
+							len -= op;
+							do {
+								*out++ = *from++;
+							} while (--op != 0U);
+							from = out - dist;
+						}
+					}
+				} else {		/* contiguous in window */
+					from += wnext - op;
+					if (op < len) {	/* some from window */
+						len -= op;
+						do {
+							*out++ = *from++;
+						} while (--op != 0U);
+						from = out - dist;
+					}
+				}
+				while (len > 2U) {
+					*out++ = *from++;
+					*out++ = *from++;
+					*out++ = *from++;
+					len -= 3U;
+				}
+				if (len != 0U) {
+					*out++ = *from++;
+					if (len > 1U)
+						*out++ = *from++;
+				}
+			} else if ((op & 64U) == 0U) {	/* 2nd level distance code */
+				here = dcode[here.val + (hold & ((1U << op) - 1U))];
+				goto dodist;
+			} else {
+				strm->msg = (char *)"invalid distance code";
+				state->mode = BAD;
+				break;
+			}
+		} else if ((op & 64U) == 0U) {		/* 2nd level length code */
+			here = lcode[here.val + (hold & ((1U << op) - 1U))];
+			goto dolen;
+		} else if ((op & 32U) != 0U) {		/* end-of-block */
+			Tracevv((stderr, "inflate:         end of block\n"));
+			state->mode = TYPE;
+			break;
+		} else {
+			strm->msg = (char *)"invalid literal/length code";
+			state->mode = BAD;
+			break;
+		}
+	} while ((in < last) && (out < end));
+
+	/*
+	 * Return the unused bytes. The bytes that have been loaded in 'hold' but
+	 * not counted in 'bits' have not been consumed from the input.
+	 */
+	len = bits >> 3;
+	in -= len;
+	bits -= len << 3;
+	hold &= ((uint64_t)1U << bits) - 1U;
+
+	/* update state and return */
+	strm->next_in = in;
+	strm->next_out = out;
+	strm->avail_in = (unsigned int)(in < last ? 5 + (last - in) :
+					 5 - (in - last));
+	strm->avail_out = (unsigned int)(out < end ? 257 + (end - out) :
+					  257 - (out - end));
+	state->hold = (unsigned long)hold;
+	state->bits = bits;
+}
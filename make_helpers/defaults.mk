@@ -27,6 +27,10 @@ ARM_ARCH_MINOR			:= 0
 # in EL3. The platform port can change this value if needed.
 ARM_GIC_ARCH			:= 2
 
+# Let BL1 hand over the certificates it has verified to BL2, so that they are
+# not verified again
+AUTH_CERT_CACHE			:= 0
+
 # Base commit to perform code check on
 BASE_COMMIT			:= origin/master
 
@@ -37,6 +41,10 @@ BL2_AT_EL3			:= 0
 # when BL2_AT_EL3 is 1.
 BL2_IN_XIP_MEM			:= 0
 
+# Let BL2 hash an image while the storage driver reads the next one. Only
+# supported when STREAM_IMAGE_HASH is 1.
+BL2_PIPELINED_LOAD		:= 0
+
 # By default, consider that the platform may release several CPUs out of reset.
 # The platform Makefile is free to override this value.
 COLD_BOOT_SINGLE_CPU		:= 0
@@ -55,6 +63,9 @@ CTX_INCLUDE_AARCH32_REGS	:= 1
 # Include FP registers in cpu context
 CTX_INCLUDE_FPREGS		:= 0
 
+# Only switch the FP registers between the worlds when a lower EL accesses them
+CTX_LAZY_FPREGS			:= 0
+
 # Debug build
 DEBUG				:= 0
 
@@ -65,6 +76,9 @@ DEFAULT_PLAT			:= fvp
 # development platforms.
 DYN_DISABLE_AUTH		:= 0
 
+# Flag to time the hot paths of the boot flow and report them on the console
+ENABLE_BOOT_PROFILING		:= 0
+
 # Build option to enable MPAM for lower ELs
 ENABLE_MPAM_FOR_LOWER_ELS	:= 0
 
@@ -77,6 +91,12 @@ ENABLE_PSCI_STAT		:= 0
 # Flag to enable runtime instrumentation using PMF
 ENABLE_RUNTIME_INSTRUMENTATION	:= 0
 
+# Flag to enable per-CPU histograms of the SMC handling latency using PMF
+ENABLE_SMC_LATENCY_HIST		:= 0
+
+# Flag to enable per-function SMC call counters in the runtime services
+ENABLE_SMC_STAT			:= 0
+
 # Flag to enable stack corruption protection
 ENABLE_STACK_PROTECTOR		:= 0
 
@@ -105,6 +125,10 @@ GENERATE_COT			:= 0
 # default, they are for Secure EL1.
 GICV2_G0_FOR_EL3		:= 0
 
+# Only save back the Secure-only GICv3 Distributor and Redistributor
+# configuration changed by the driver since the context was last saved.
+GICV3_TRACK_SECURE_CONFIG	:= 0
+
 # Route External Aborts to EL3. Disabled by default; External Aborts are handled
 # by lower ELs.
 HANDLE_EA_EL3_FIRST		:= 0
@@ -119,6 +143,9 @@ KEY_ALG				:= rsa
 # Flag to enable new version of image loading
 LOAD_IMAGE_V2			:= 0
 
+# Let memset() use DC ZVA for large zero fills when the MMU is enabled
+MEMSET_USE_DCZVA		:= 0
+
 # Enable use of the console API allowing multiple consoles to be registered
 # at the same time.
 MULTI_CONSOLE_API		:= 0
@@ -133,6 +160,10 @@ PL011_GENERIC_UART		:= 0
 # The platform Makefile is free to override this value.
 PROGRAMMABLE_RESET_ADDRESS	:= 0
 
+# Coordinate power domain states with atomic per power domain counters instead
+# of per power domain locks
+PSCI_ATOMIC_COORDINATION	:= 0
+
 # Flag used to choose the power state format viz Extended State-ID or the
 # Original format.
 PSCI_EXTENDED_STATE_ID		:= 0
@@ -166,12 +197,23 @@ ENABLE_SPM			:= 0
 # image. This is meant to help debugging the post-BL2 phase.
 SPIN_ON_BL1_EXIT		:= 0
 
+# Flag to decompress the compressed images while they are read, rather than
+# loading them into a temporary buffer first.
+STREAM_IMAGE_DECOMPRESS		:= 0
+
+# Flag to calculate the hash of the images authenticated by their hash while
+# they are read, rather than in a separate pass once they have been loaded.
+STREAM_IMAGE_HASH		:= 0
+
 # Flags to build TF with Trusted Boot support
 TRUSTED_BOARD_BOOT		:= 0
 
 # Build option to choose whether Trusted firmware uses Coherent memory or not.
 USE_COHERENT_MEM		:= 1
 
+# Build option to implement bakery locks as queued ticket locks
+USE_QUEUED_BAKERY_LOCK		:= 0
+
 # Build option to choose wheter Trusted firmware uses library at ROM
 USE_ROMLIB				:= 0
 
@@ -187,6 +229,10 @@ V				:= 0
 # platforms).
 WARMBOOT_ENABLE_DCACHE_EARLY	:= 0
 
+# Merge the translation table entries that map contiguous memory with the same
+# attributes into larger blocks and contiguous runs.
+XLAT_TABLES_COALESCE		:= 0
+
 # Build option to enable/disable the Statistical Profiling Extensions
 ENABLE_SPE_FOR_LOWER_ELS	:= 1
 
@@ -36,6 +36,10 @@
 
 #define PLAT_MAX_PWR_LVL		ARM_PWR_LVL2
 
+/* Queue bakery lock contenders per cluster */
+#define PLAT_BAKERY_LOCK_QUEUE_CPUS	\
+	(FVP_MAX_CPUS_PER_CLUSTER * FVP_MAX_PE_PER_CPU)
+
 /*
  * Other platform porting definitions are provided by included headers
  */
@@ -133,8 +133,7 @@ void arm_load_tb_fw_config(void)
 		SET_STATIC_PARAM_HEAD(image_info, PARAM_IMAGE_BINARY,
 				VERSION_2, image_info_t, 0),
 		.image_info.image_base = ARM_TB_FW_CONFIG_BASE,
-		.image_info.image_max_size =
-			ARM_TB_FW_CONFIG_LIMIT - ARM_TB_FW_CONFIG_BASE
+		.image_info.image_max_size = ARM_TB_FW_CONFIG_MAX_SIZE
 	};
 
 	VERBOSE("BL1: Loading TB_FW_CONFIG\n");
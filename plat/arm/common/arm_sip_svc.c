@@ -8,6 +8,7 @@
 #include <debug.h>
 #include <plat_arm.h>
 #include <pmf.h>
+#include <psci.h>
 #include <runtime_svc.h>
 #include <stdint.h>
 #include <uuid.h>
@@ -69,6 +70,23 @@ static uintptr_t arm_sip_handler(unsigned int smc_fid,
 				(uint32_t) x4, handle);
 		}
 
+	case ARM_SIP_SVC_CPU_ON_BATCH: {
+		u_register_t on_map;
+		int rc;
+
+		/* Allow calls from non-secure only */
+		if (!is_caller_non_secure(flags))
+			SMC_RET1(handle, PSCI_E_DENIED);
+
+		rc = psci_cpu_on_batch(x1, x2, x3, x4, &on_map);
+		SMC_RET2(handle, rc, on_map);
+		}
+
+#if ENABLE_SMC_STAT
+	case ARM_SIP_SVC_SMC_COUNT:
+		SMC_RET1(handle, runtime_svc_stat_get_count((uint32_t) x1));
+#endif
+
 	case ARM_SIP_SVC_CALL_COUNT:
 		/* PMF calls */
 		call_count += PMF_NUM_SMC_CALLS;
@@ -76,6 +94,14 @@ static uintptr_t arm_sip_handler(unsigned int smc_fid,
 		/* State switch call */
 		call_count += 1;
 
+		/* Batched CPU on call */
+		call_count += 1;
+
+#if ENABLE_SMC_STAT
+		/* SMC count call */
+		call_count += 1;
+#endif
+
 		SMC_RET1(handle, call_count);
 
 	case ARM_SIP_SVC_UID:
@@ -103,3 +129,23 @@ DECLARE_RT_SVC(
 	arm_sip_setup,
 	arm_sip_handler
 );
+
+/*
+ * Register the PMF calls so that they are dispatched straight to the PMF SMC
+ * handler. PMF function IDs are a block of 32 function numbers.
+ */
+DECLARE_RT_SVC_FID(
+	arm_sip_pmf32,
+	PMF_SMC_GET_TIMESTAMP_32 & ~FUNCID_NUM_MASK,
+	(PMF_SMC_GET_TIMESTAMP_32 & ~FUNCID_NUM_MASK) |
+		(FUNCID_NUM_MASK & ~PMF_FID_MASK),
+	pmf_smc_handler
+);
+
+DECLARE_RT_SVC_FID(
+	arm_sip_pmf64,
+	PMF_SMC_GET_TIMESTAMP_64 & ~FUNCID_NUM_MASK,
+	(PMF_SMC_GET_TIMESTAMP_64 & ~FUNCID_NUM_MASK) |
+		(FUNCID_NUM_MASK & ~PMF_FID_MASK),
+	pmf_smc_handler
+);
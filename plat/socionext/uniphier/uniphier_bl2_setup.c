@@ -15,6 +15,9 @@
 #ifdef UNIPHIER_DECOMPRESS_GZIP
 #include <tf_gunzip.h>
 #endif
+#ifdef UNIPHIER_DECOMPRESS_LZ4
+#include <lz4_decompress.h>
+#endif
 #include <xlat_tables_v2.h>
 
 #include "uniphier.h"
@@ -24,6 +27,26 @@
 
 static int uniphier_bl2_kick_scp;
 
+#if defined(UNIPHIER_DECOMPRESS_GZIP) || defined(UNIPHIER_DECOMPRESS_LZ4)
+#define UNIPHIER_DECOMPRESS
+#endif
+
+#if defined(UNIPHIER_DECOMPRESS_GZIP) && STREAM_IMAGE_DECOMPRESS
+static const decompressor_stream_t uniphier_gunzip_stream = {
+	.start = gunzip_stream_start,
+	.update = gunzip_stream_update,
+	.finish = gunzip_stream_finish,
+};
+#endif
+
+#if defined(UNIPHIER_DECOMPRESS_LZ4) && STREAM_IMAGE_DECOMPRESS
+static const decompressor_stream_t uniphier_lz4_stream = {
+	.start = lz4_stream_start,
+	.update = lz4_stream_update,
+	.finish = lz4_stream_finish,
+};
+#endif
+
 void bl2_el3_early_platform_setup(u_register_t x0, u_register_t x1,
 				  u_register_t x2, u_register_t x3)
 {
@@ -128,15 +151,32 @@ bl_params_t *plat_get_next_bl_params(void)
 void bl2_plat_preload_setup(void)
 {
 #ifdef UNIPHIER_DECOMPRESS_GZIP
+#if STREAM_IMAGE_DECOMPRESS
+	image_decompress_init_stream(UNIPHIER_IMAGE_BUF_BASE,
+				     UNIPHIER_IMAGE_BUF_SIZE,
+				     &uniphier_gunzip_stream);
+#else
 	image_decompress_init(UNIPHIER_IMAGE_BUF_BASE,
 			      UNIPHIER_IMAGE_BUF_SIZE,
 			      gunzip);
 #endif
+#endif
+#ifdef UNIPHIER_DECOMPRESS_LZ4
+#if STREAM_IMAGE_DECOMPRESS
+	image_decompress_init_stream(UNIPHIER_IMAGE_BUF_BASE,
+				     UNIPHIER_IMAGE_BUF_SIZE,
+				     &uniphier_lz4_stream);
+#else
+	image_decompress_init(UNIPHIER_IMAGE_BUF_BASE,
+			      UNIPHIER_IMAGE_BUF_SIZE,
+			      lz4_decompress);
+#endif
+#endif
 }
 
 int bl2_plat_handle_pre_image_load(unsigned int image_id)
 {
-#ifdef UNIPHIER_DECOMPRESS_GZIP
+#ifdef UNIPHIER_DECOMPRESS
 	image_decompress_prepare(uniphier_get_image_info(image_id));
 #endif
 	return 0;
@@ -144,7 +184,7 @@ int bl2_plat_handle_pre_image_load(unsigned int image_id)
 
 int bl2_plat_handle_post_image_load(unsigned int image_id)
 {
-#ifdef UNIPHIER_DECOMPRESS_GZIP
+#ifdef UNIPHIER_DECOMPRESS
 	struct image_info *image_info;
 	int ret;
 
@@ -19,9 +19,12 @@
 #include <bl31.h>
 #include <bl_common.h>
 #include <context_mgmt.h>
+#include <cpu_data.h>
 #include <debug.h>
 #include <errno.h>
 #include <platform.h>
+#include <pmf.h>
+#include <runtime_instr.h>
 #include <runtime_svc.h>
 #include <stddef.h>
 #include <uuid.h>
@@ -134,6 +137,14 @@ static int32_t opteed_setup(void)
 				dt_addr,
 				&opteed_sp_context[linear_id]);
 
+	/*
+	 * OPTEE cannot access the AArch32 EL1 system registers when it runs in
+	 * AArch64, so they are left out of the world switches.
+	 */
+	if (opteed_rw == OPTEE_AARCH64)
+		cm_set_el1_sysregs_mask(CTX_EL1_SYSREGS_ALL &
+					~CTX_EL1_SYSREGS_AARCH32);
+
 	/*
 	 * All OPTEED initialization done. Now register our init function with
 	 * BL31 for deferred invocation
@@ -214,6 +225,16 @@ static uintptr_t opteed_smc_handler(uint32_t smc_fid,
 		 */
 		assert(handle == cm_get_context(NON_SECURE));
 
+#if ENABLE_RUNTIME_INSTRUMENTATION
+		PMF_WRITE_TIMESTAMP(rt_instr_svc,
+		    RT_INSTR_ENTER_SPD,
+		    PMF_NO_CACHE_MAINT,
+		    get_cpu_data(cpu_data_pmf_ts[CPU_DATA_PMF_TS0_IDX]));
+		PMF_CAPTURE_TIMESTAMP(rt_instr_svc,
+		    RT_INSTR_ENTER_SPD_SWITCH,
+		    PMF_NO_CACHE_MAINT);
+#endif
+
 		cm_el1_sysregs_context_save(NON_SECURE);
 
 		/*
@@ -263,6 +284,12 @@ static uintptr_t opteed_smc_handler(uint32_t smc_fid,
 			      read_ctx_reg(get_gpregs_ctx(handle),
 					   CTX_GPREG_X7));
 
+#if ENABLE_RUNTIME_INSTRUMENTATION
+		PMF_CAPTURE_TIMESTAMP(rt_instr_svc,
+		    RT_INSTR_EXIT_SPD_SWITCH,
+		    PMF_NO_CACHE_MAINT);
+#endif
+
 		SMC_RET4(&optee_ctx->cpu_ctx, smc_fid, x1, x2, x3);
 	}
 
@@ -360,6 +387,14 @@ static uintptr_t opteed_smc_handler(uint32_t smc_fid,
 		 * and return to the non-secure state.
 		 */
 		assert(handle == cm_get_context(SECURE));
+
+#if ENABLE_RUNTIME_INSTRUMENTATION
+		PMF_WRITE_TIMESTAMP(rt_instr_svc,
+		    RT_INSTR_ENTER_SPD_RETURN,
+		    PMF_NO_CACHE_MAINT,
+		    get_cpu_data(cpu_data_pmf_ts[CPU_DATA_PMF_TS0_IDX]));
+#endif
+
 		cm_el1_sysregs_context_save(SECURE);
 
 		/* Get a reference to the non-secure context */
@@ -370,6 +405,12 @@ static uintptr_t opteed_smc_handler(uint32_t smc_fid,
 		cm_el1_sysregs_context_restore(NON_SECURE);
 		cm_set_next_eret_context(NON_SECURE);
 
+#if ENABLE_RUNTIME_INSTRUMENTATION
+		PMF_CAPTURE_TIMESTAMP(rt_instr_svc,
+		    RT_INSTR_EXIT_SPD,
+		    PMF_NO_CACHE_MAINT);
+#endif
+
 		SMC_RET4(ns_cpu_context, x1, x2, x3, x4);
 
 	/*
@@ -97,14 +97,17 @@ static struct args trusty_context_switch(uint32_t security_state, uint64_t r0,
 	ret.r1 = r1;
 	ret.r0 = r0;
 
+#if !CTX_LAZY_FPREGS
 	/*
 	 * To avoid the additional overhead in PSCI flow, skip FP context
 	 * saving/restoring in case of CPU suspend and resume, asssuming that
 	 * when it's needed the PSCI caller has preserved FP context before
-	 * going here.
+	 * going here. With CTX_LAZY_FPREGS, the FP registers are switched on
+	 * their first access instead.
 	 */
 	if (r0 != SMC_FC_CPU_SUSPEND && r0 != SMC_FC_CPU_RESUME)
 		fpregs_context_save(get_fpregs_ctx(cm_get_context(security_state)));
+#endif
 	cm_el1_sysregs_context_save(security_state);
 
 	ctx->saved_security_state = security_state;
@@ -113,8 +116,10 @@ static struct args trusty_context_switch(uint32_t security_state, uint64_t r0,
 	assert(ctx->saved_security_state == !security_state);
 
 	cm_el1_sysregs_context_restore(security_state);
+#if !CTX_LAZY_FPREGS
 	if (r0 != SMC_FC_CPU_SUSPEND && r0 != SMC_FC_CPU_RESUME)
 		fpregs_context_restore(get_fpregs_ctx(cm_get_context(security_state)));
+#endif
 
 	cm_set_next_eret_context(security_state);
 
@@ -293,7 +298,9 @@ static int32_t trusty_init(void)
 	ep_info = bl31_plat_get_next_image_ep_info(SECURE);
 	assert(ep_info);
 
+#if !CTX_LAZY_FPREGS
 	fpregs_context_save(get_fpregs_ctx(cm_get_context(NON_SECURE)));
+#endif
 	cm_el1_sysregs_context_save(NON_SECURE);
 
 	cm_set_context(&ctx->cpu_ctx, SECURE);
@@ -310,7 +317,9 @@ static int32_t trusty_init(void)
 	}
 
 	cm_el1_sysregs_context_restore(SECURE);
+#if !CTX_LAZY_FPREGS
 	fpregs_context_restore(get_fpregs_ctx(cm_get_context(SECURE)));
+#endif
 	cm_set_next_eret_context(SECURE);
 
 	ctx->saved_security_state = ~0; /* initial saved state is invalid */
@@ -319,7 +328,9 @@ static int32_t trusty_init(void)
 	trusty_context_switch_helper(&ctx->saved_sp, &zero_args);
 
 	cm_el1_sysregs_context_restore(NON_SECURE);
+#if !CTX_LAZY_FPREGS
 	fpregs_context_restore(get_fpregs_ctx(cm_get_context(NON_SECURE)));
+#endif
 	cm_set_next_eret_context(NON_SECURE);
 
 	return 1;
@@ -431,6 +442,14 @@ static int32_t trusty_setup(void)
 	(void)memset(&ep_info->args, 0, sizeof(ep_info->args));
 	plat_trusty_set_boot_args(&ep_info->args);
 
+	/*
+	 * Trusty cannot access the AArch32 EL1 system registers when it runs
+	 * in AArch64, so they are left out of the world switches.
+	 */
+	if (!aarch32)
+		cm_set_el1_sysregs_mask(CTX_EL1_SYSREGS_ALL &
+					~CTX_EL1_SYSREGS_AARCH32);
+
 	/* register init handler */
 	bl31_register_bl32_init(trusty_init);
 
@@ -101,6 +101,7 @@ void tspd_synchronous_sp_exit(tsp_context_t *tsp_ctx, uint64_t ret)
 	/* Save the Secure EL1 system register context */
 	assert(cm_get_context(SECURE) == &tsp_ctx->cpu_ctx);
 	cm_el1_sysregs_context_save(SECURE);
+	clr_sysregs_saved_idle_flag(tsp_ctx->state);
 
 	assert(tsp_ctx->c_rt_ctx != 0);
 	tspd_exit_sp(tsp_ctx->c_rt_ctx, ret);
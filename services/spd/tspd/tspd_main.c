@@ -19,10 +19,13 @@
 #include <bl31.h>
 #include <bl_common.h>
 #include <context_mgmt.h>
+#include <cpu_data.h>
 #include <debug.h>
 #include <ehf.h>
 #include <errno.h>
 #include <platform.h>
+#include <pmf.h>
+#include <runtime_instr.h>
 #include <runtime_svc.h>
 #include <stddef.h>
 #include <string.h>
@@ -61,6 +64,8 @@ uint64_t tspd_handle_sp_preemption(void *handle)
 
 	assert(handle == cm_get_context(SECURE));
 	cm_el1_sysregs_context_save(SECURE);
+	clr_sysregs_saved_idle_flag(
+		tspd_sp_context[plat_my_core_pos()].state);
 	/* Get a reference to the non-secure context */
 	ns_cpu_context = cm_get_context(NON_SECURE);
 	assert(ns_cpu_context);
@@ -217,6 +222,8 @@ static int32_t tspd_setup(void)
 				tsp_ep_info->pc,
 				&tspd_sp_context[linear_id]);
 
+	cm_set_el1_sysregs_mask(TSPD_EL1_SYSREGS);
+
 #if TSP_INIT_ASYNC
 	bl31_set_next_image_type(SECURE);
 #else
@@ -417,6 +424,7 @@ static uintptr_t tspd_smc_handler(uint32_t smc_fid,
 		/* Save the Secure EL1 system register context */
 		assert(cm_get_context(SECURE) == &tsp_ctx->cpu_ctx);
 		cm_el1_sysregs_context_save(SECURE);
+		clr_sysregs_saved_idle_flag(tsp_ctx->state);
 
 		/* Program EL3 registers to enable entry into the next EL */
 		next_image_info = bl31_plat_get_next_image_ep_info(NON_SECURE);
@@ -487,11 +495,13 @@ static uintptr_t tspd_smc_handler(uint32_t smc_fid,
 	case TSP_FAST_FID(TSP_SUB):
 	case TSP_FAST_FID(TSP_MUL):
 	case TSP_FAST_FID(TSP_DIV):
+	case TSP_FAST_FID(TSP_NULL):
 
 	case TSP_YIELD_FID(TSP_ADD):
 	case TSP_YIELD_FID(TSP_SUB):
 	case TSP_YIELD_FID(TSP_MUL):
 	case TSP_YIELD_FID(TSP_DIV):
+	case TSP_YIELD_FID(TSP_NULL):
 		if (ns) {
 			/*
 			 * This is a fresh request from the non-secure client.
@@ -505,6 +515,16 @@ static uintptr_t tspd_smc_handler(uint32_t smc_fid,
 			if (get_yield_smc_active_flag(tsp_ctx->state))
 				SMC_RET1(handle, SMC_UNK);
 
+#if ENABLE_RUNTIME_INSTRUMENTATION
+			PMF_WRITE_TIMESTAMP(rt_instr_svc,
+			    RT_INSTR_ENTER_SPD,
+			    PMF_NO_CACHE_MAINT,
+			    get_cpu_data(cpu_data_pmf_ts[CPU_DATA_PMF_TS0_IDX]));
+			PMF_CAPTURE_TIMESTAMP(rt_instr_svc,
+			    RT_INSTR_ENTER_SPD_SWITCH,
+			    PMF_NO_CACHE_MAINT);
+#endif
+
 			cm_el1_sysregs_context_save(NON_SECURE);
 
 			/* Save x1 and x2 for use by TSP_GET_ARGS call below */
@@ -560,6 +580,13 @@ static uintptr_t tspd_smc_handler(uint32_t smc_fid,
 
 			cm_el1_sysregs_context_restore(SECURE);
 			cm_set_next_eret_context(SECURE);
+
+#if ENABLE_RUNTIME_INSTRUMENTATION
+			PMF_CAPTURE_TIMESTAMP(rt_instr_svc,
+			    RT_INSTR_EXIT_SPD_SWITCH,
+			    PMF_NO_CACHE_MAINT);
+#endif
+
 			SMC_RET3(&tsp_ctx->cpu_ctx, smc_fid, x1, x2);
 		} else {
 			/*
@@ -567,9 +594,42 @@ static uintptr_t tspd_smc_handler(uint32_t smc_fid,
 			 * earlier request. The results are in x1-x3. Copy it
 			 * into the non-secure context, save the secure state
 			 * and return to the non-secure state.
+			 *
+			 * The saved secure system register context is still
+			 * valid if it was saved when the TSP returned its
+			 * previous result. Saving an empty set of registers
+			 * still notifies the exit from the secure world.
 			 */
 			assert(handle == cm_get_context(SECURE));
-			cm_el1_sysregs_context_save(SECURE);
+
+#if ENABLE_RUNTIME_INSTRUMENTATION
+			PMF_WRITE_TIMESTAMP(rt_instr_svc,
+			    RT_INSTR_ENTER_SPD_RETURN,
+			    PMF_NO_CACHE_MAINT,
+			    get_cpu_data(cpu_data_pmf_ts[CPU_DATA_PMF_TS0_IDX]));
+
+			/*
+			 * The null service returns the times at which the TSP
+			 * started and finished handling the call in x2 and x3.
+			 */
+			if (TSP_BARE_FID(smc_fid) == TSP_NULL) {
+				PMF_WRITE_TIMESTAMP(rt_instr_svc,
+				    RT_INSTR_ENTER_SP,
+				    PMF_NO_CACHE_MAINT,
+				    x2);
+				PMF_WRITE_TIMESTAMP(rt_instr_svc,
+				    RT_INSTR_EXIT_SP,
+				    PMF_NO_CACHE_MAINT,
+				    x3);
+			}
+#endif
+
+			if (get_sysregs_saved_idle_flag(tsp_ctx->state) == 0) {
+				cm_el1_sysregs_context_save(SECURE);
+				set_sysregs_saved_idle_flag(tsp_ctx->state);
+			} else {
+				cm_el1_sysregs_context_save_mask(SECURE, 0U);
+			}
 
 			/* Get a reference to the non-secure context */
 			ns_cpu_context = cm_get_context(NON_SECURE);
@@ -590,6 +650,12 @@ static uintptr_t tspd_smc_handler(uint32_t smc_fid,
 #endif
 			}
 
+#if ENABLE_RUNTIME_INSTRUMENTATION
+			PMF_CAPTURE_TIMESTAMP(rt_instr_svc,
+			    RT_INSTR_EXIT_SPD,
+			    PMF_NO_CACHE_MAINT);
+#endif
+
 			SMC_RET3(ns_cpu_context, x1, x2, x3);
 		}
 
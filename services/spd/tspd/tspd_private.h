@@ -52,6 +52,36 @@
 					~(YIELD_SMC_ACTIVE_FLAG_MASK	\
 					<< YIELD_SMC_ACTIVE_FLAG_SHIFT))
 
+/*
+ * This flag is set when the saved S-EL1 system register context is the one of
+ * the TSP waiting for a new fast or yielding SMC request, i.e. it was saved
+ * when the TSP returned the result of such a request. The TSP comes back to
+ * this context when it returns the result of the next request, so the TSPD
+ * does not need to save it again then.
+ */
+#define SYSREGS_SAVED_IDLE_FLAG_SHIFT	3
+#define SYSREGS_SAVED_IDLE_FLAG_MASK	1
+#define get_sysregs_saved_idle_flag(state)				\
+				((state >> SYSREGS_SAVED_IDLE_FLAG_SHIFT) \
+				& SYSREGS_SAVED_IDLE_FLAG_MASK)
+#define set_sysregs_saved_idle_flag(state)	(state |=		\
+					1 << SYSREGS_SAVED_IDLE_FLAG_SHIFT)
+#define clr_sysregs_saved_idle_flag(state)	(state &=		\
+					~(SYSREGS_SAVED_IDLE_FLAG_MASK	\
+					<< SYSREGS_SAVED_IDLE_FLAG_SHIFT))
+
+/*
+ * Groups of EL1 system registers switched between the TSP and the Normal
+ * world. The TSP runs in AArch64, so the AArch32 registers are left out. The
+ * EL1 physical timer registers are switched when NS_TIMER_SWITCH is set, so
+ * that the Non-secure timer is disabled while the TSP runs.
+ */
+#if NS_TIMER_SWITCH
+#define TSPD_EL1_SYSREGS	(CTX_EL1_SYSREGS_CORE | CTX_EL1_SYSREGS_TIMER)
+#else
+#define TSPD_EL1_SYSREGS	CTX_EL1_SYSREGS_CORE
+#endif
+
 /*******************************************************************************
  * Secure Payload execution state information i.e. aarch32 or aarch64
  ******************************************************************************/
@@ -59,10 +59,11 @@ static int32_t std_svc_setup(void)
 }
 
 /*
- * Top-level Standard Service SMC handler. This handler will in turn dispatch
- * calls to PSCI SMC handler
+ * PSCI SMC handler. PSCI function IDs are dispatched here directly by the
+ * runtime service framework, or through the top-level Standard Service SMC
+ * handler.
  */
-static uintptr_t std_svc_smc_handler(uint32_t smc_fid,
+static uintptr_t std_svc_psci_handler(uint32_t smc_fid,
 			     u_register_t x1,
 			     u_register_t x2,
 			     u_register_t x3,
@@ -71,35 +72,72 @@ static uintptr_t std_svc_smc_handler(uint32_t smc_fid,
 			     void *handle,
 			     u_register_t flags)
 {
-	/*
-	 * Dispatch PSCI calls to PSCI SMC handler and return its return
-	 * value
-	 */
-	if (is_psci_fid(smc_fid)) {
-		uint64_t ret;
+	uint64_t ret;
 
 #if ENABLE_RUNTIME_INSTRUMENTATION
 
-		/*
-		 * Flush cache line so that even if CPU power down happens
-		 * the timestamp update is reflected in memory.
-		 */
-		PMF_WRITE_TIMESTAMP(rt_instr_svc,
-		    RT_INSTR_ENTER_PSCI,
-		    PMF_CACHE_MAINT,
-		    get_cpu_data(cpu_data_pmf_ts[CPU_DATA_PMF_TS0_IDX]));
+	/*
+	 * Flush cache line so that even if CPU power down happens
+	 * the timestamp update is reflected in memory.
+	 */
+	PMF_WRITE_TIMESTAMP(rt_instr_svc,
+	    RT_INSTR_ENTER_PSCI,
+	    PMF_CACHE_MAINT,
+	    get_cpu_data(cpu_data_pmf_ts[CPU_DATA_PMF_TS0_IDX]));
 #endif
 
-		ret = psci_smc_handler(smc_fid, x1, x2, x3, x4,
-		    cookie, handle, flags);
+	ret = psci_smc_handler(smc_fid, x1, x2, x3, x4,
+	    cookie, handle, flags);
 
 #if ENABLE_RUNTIME_INSTRUMENTATION
-		PMF_CAPTURE_TIMESTAMP(rt_instr_svc,
-		    RT_INSTR_EXIT_PSCI,
-		    PMF_NO_CACHE_MAINT);
+	PMF_CAPTURE_TIMESTAMP(rt_instr_svc,
+	    RT_INSTR_EXIT_PSCI,
+	    PMF_NO_CACHE_MAINT);
+#endif
+
+	SMC_RET1(handle, ret);
+}
+
+#if SDEI_SUPPORT
+/*
+ * SDEI SMC handler. SDEI function IDs are dispatched here directly by the
+ * runtime service framework, or through the top-level Standard Service SMC
+ * handler.
+ */
+static uintptr_t std_svc_sdei_handler(uint32_t smc_fid,
+			     u_register_t x1,
+			     u_register_t x2,
+			     u_register_t x3,
+			     u_register_t x4,
+			     void *cookie,
+			     void *handle,
+			     u_register_t flags)
+{
+	return sdei_smc_handler(smc_fid, x1, x2, x3, x4, cookie, handle,
+			flags);
+}
 #endif
 
-		SMC_RET1(handle, ret);
+/*
+ * Top-level Standard Service SMC handler. This handler will in turn dispatch
+ * calls to PSCI SMC handler
+ */
+static uintptr_t std_svc_smc_handler(uint32_t smc_fid,
+			     u_register_t x1,
+			     u_register_t x2,
+			     u_register_t x3,
+			     u_register_t x4,
+			     void *cookie,
+			     void *handle,
+			     u_register_t flags)
+{
+	/*
+	 * Dispatch PSCI calls to PSCI SMC handler and return its return
+	 * value
+	 */
+	if (is_psci_fid(smc_fid)) {
+		return std_svc_psci_handler(smc_fid, x1, x2, x3, x4, cookie,
+				handle, flags);
 	}
 
 #if ENABLE_SPM
@@ -115,8 +153,8 @@ static uintptr_t std_svc_smc_handler(uint32_t smc_fid,
 
 #if SDEI_SUPPORT
 	if (is_sdei_fid(smc_fid)) {
-		return sdei_smc_handler(smc_fid, x1, x2, x3, x4, cookie, handle,
-				flags);
+		return std_svc_sdei_handler(smc_fid, x1, x2, x3, x4, cookie,
+				handle, flags);
 	}
 #endif
 
@@ -152,3 +190,35 @@ DECLARE_RT_SVC(
 		std_svc_setup,
 		std_svc_smc_handler
 );
+
+/*
+ * Register the hot Standard Service Calls so that they are dispatched straight
+ * to their handler. The PSCI and SDEI function IDs are blocks of 32 function
+ * numbers.
+ */
+#define STD_SVC_FID_BLOCK_END(_fid)	((_fid) | (FUNCID_NUM_MASK & ~PSCI_FID_MASK))
+#define STD_SVC_FID_SMC64(_fid)		((_fid) | (SMC_64 << FUNCID_CC_SHIFT))
+
+DECLARE_RT_SVC_FID(
+		std_svc_psci32,
+		PSCI_VERSION,
+		STD_SVC_FID_BLOCK_END(PSCI_VERSION),
+		std_svc_psci_handler
+);
+
+DECLARE_RT_SVC_FID(
+		std_svc_psci64,
+		STD_SVC_FID_SMC64(PSCI_VERSION),
+		STD_SVC_FID_BLOCK_END(STD_SVC_FID_SMC64(PSCI_VERSION)),
+		std_svc_psci_handler
+);
+
+#if SDEI_SUPPORT
+/* SDEI calls use the SMC64 calling convention only */
+DECLARE_RT_SVC_FID(
+		std_svc_sdei64,
+		SDEI_VERSION,
+		STD_SVC_FID_BLOCK_END(SDEI_VERSION),
+		std_svc_sdei_handler
+);
+#endif
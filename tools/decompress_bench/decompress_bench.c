@@ -0,0 +1,335 @@
+/*
+ * Copyright (c) 2018, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <lz4_decompress.h>
+#include <tf_gunzip.h>
+
+/*
+ * Host checker and benchmark of the image decompressors of lib/. Each
+ * compressed image is decompressed in one call at every input alignment and
+ * with the streaming interface in chunks of various sizes, and the output is
+ * compared with the original image. The one-call decompression is then timed.
+ */
+
+/* Size of the work buffer given to the decompressors */
+#define WORK_BUF_SIZE		(4U << 20)
+/* Minimum duration of a timed run, in seconds */
+#define BENCH_MIN_TIME		0.2
+/* Number of timed runs, the fastest one is reported */
+#define BENCH_RUNS		5
+
+typedef struct decompressor {
+	const char *name;
+	const uint8_t *magic;
+	size_t magic_len;
+	int (*decompress)(uintptr_t *in_buf, size_t in_len, uintptr_t *out_buf,
+			  size_t out_len, uintptr_t work_buf, size_t work_len);
+	int (*stream_start)(uintptr_t out_buf, size_t out_len,
+			    uintptr_t work_buf, size_t work_len);
+	int (*stream_update)(uintptr_t in_buf, size_t in_len);
+	int (*stream_finish)(uintptr_t *out_buf);
+} decompressor_t;
+
+static const uint8_t gzip_magic[] = { 0x1f, 0x8b };
+static const uint8_t lz4_magic[] = { 0x04, 0x22, 0x4d, 0x18 };
+
+static const decompressor_t decompressors[] = {
+	{
+		.name = "gzip",
+		.magic = gzip_magic,
+		.magic_len = sizeof(gzip_magic),
+		.decompress = gunzip,
+		.stream_start = gunzip_stream_start,
+		.stream_update = gunzip_stream_update,
+		.stream_finish = gunzip_stream_finish,
+	},
+	{
+		.name = "lz4",
+		.magic = lz4_magic,
+		.magic_len = sizeof(lz4_magic),
+		.decompress = lz4_decompress,
+		.stream_start = lz4_stream_start,
+		.stream_update = lz4_stream_update,
+		.stream_finish = lz4_stream_finish,
+	},
+};
+
+/* Sizes of the chunks given to the streaming interface */
+static const size_t chunk_sizes[] = { 1, 3, 13, 511, 4096, 65537 };
+
+static uint8_t *work_buf;
+
+static uint8_t *read_file(const char *filename, size_t *len)
+{
+	FILE *fp;
+	uint8_t *buf;
+	long size;
+
+	fp = fopen(filename, "rb");
+	if (fp == NULL) {
+		perror(filename);
+		return NULL;
+	}
+
+	if ((fseek(fp, 0, SEEK_END) != 0) || ((size = ftell(fp)) < 0) ||
+	    (fseek(fp, 0, SEEK_SET) != 0)) {
+		perror(filename);
+		fclose(fp);
+		return NULL;
+	}
+
+	/* Leave room to move the data to any alignment */
+	buf = malloc((size_t)size + 8U);
+	if (buf == NULL) {
+		fprintf(stderr, "%s: out of memory\n", filename);
+		fclose(fp);
+		return NULL;
+	}
+
+	if (fread(buf, 1, (size_t)size, fp) != (size_t)size) {
+		fprintf(stderr, "%s: failed to read the file\n", filename);
+		free(buf);
+		fclose(fp);
+		return NULL;
+	}
+
+	fclose(fp);
+	*len = (size_t)size;
+
+	return buf;
+}
+
+static const decompressor_t *find_decompressor(const uint8_t *buf,
+					       size_t len)
+{
+	unsigned int i;
+
+	for (i = 0U; i < sizeof(decompressors) / sizeof(decompressors[0]);
+	     i++) {
+		if ((len >= decompressors[i].magic_len) &&
+		    (memcmp(buf, decompressors[i].magic,
+			    decompressors[i].magic_len) == 0))
+			return &decompressors[i];
+	}
+
+	return NULL;
+}
+
+static double now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return (double)ts.tv_sec + ((double)ts.tv_nsec * 1e-9);
+}
+
+/*
+ * Decompress 'in' in one call and compare the output with 'ref'. Return 0 if
+ * the output matches, -1 otherwise.
+ */
+static int check_one_call(const decompressor_t *dec, const uint8_t *in,
+			  size_t in_len, uint8_t *out, const uint8_t *ref,
+			  size_t ref_len)
+{
+	uintptr_t in_buf = (uintptr_t)in;
+	uintptr_t out_buf = (uintptr_t)out;
+	int ret;
+
+	memset(out, 0, ref_len);
+	ret = dec->decompress(&in_buf, in_len, &out_buf, ref_len,
+			      (uintptr_t)work_buf, WORK_BUF_SIZE);
+	if ((ret != 0) || (out_buf != (uintptr_t)out + ref_len) ||
+	    (memcmp(out, ref, ref_len) != 0))
+		return -1;
+
+	return 0;
+}
+
+/*
+ * Decompress 'in' with the streaming interface, in chunks of 'chunk_size'
+ * bytes, and compare the output with 'ref'. Return 0 if the output matches,
+ * -1 otherwise.
+ */
+static int check_stream(const decompressor_t *dec, const uint8_t *in,
+			size_t in_len, size_t chunk_size, uint8_t *out,
+			const uint8_t *ref, size_t ref_len)
+{
+	uintptr_t out_end;
+	size_t pos, len;
+	int ret;
+
+	memset(out, 0, ref_len);
+	ret = dec->stream_start((uintptr_t)out, ref_len, (uintptr_t)work_buf,
+				WORK_BUF_SIZE);
+	for (pos = 0U; (ret == 0) && (pos < in_len); pos += len) {
+		len = in_len - pos;
+		if (len > chunk_size)
+			len = chunk_size;
+		ret = dec->stream_update((uintptr_t)in + pos, len);
+	}
+
+	if ((dec->stream_finish(&out_end) != 0) || (ret != 0) ||
+	    (out_end != (uintptr_t)out + ref_len) ||
+	    (memcmp(out, ref, ref_len) != 0))
+		return -1;
+
+	return 0;
+}
+
+static int check(const char *filename, const decompressor_t *dec, uint8_t *in,
+		 size_t in_len, uint8_t *out, const uint8_t *ref,
+		 size_t ref_len)
+{
+	uintptr_t in_buf, out_buf;
+	unsigned int i;
+	int ret = 0;
+
+	/* One call, at every alignment of the input */
+	for (i = 0U; i < 8U; i++) {
+		memmove(in + i, in, in_len);
+		if (check_one_call(dec, in + i, in_len, out, ref, ref_len)) {
+			printf("%s: one call, input offset %u: FAIL\n",
+			       filename, i);
+			ret = -1;
+		}
+		memmove(in, in + i, in_len);
+	}
+
+	for (i = 0U; i < sizeof(chunk_sizes) / sizeof(chunk_sizes[0]); i++) {
+		if (check_stream(dec, in, in_len, chunk_sizes[i], out, ref,
+				 ref_len)) {
+			printf("%s: streamed, %zu byte chunks: FAIL\n",
+			       filename, chunk_sizes[i]);
+			ret = -1;
+		}
+	}
+
+	/* The decompression must fail if the output buffer is too small */
+	if (ref_len != 0U) {
+		in_buf = (uintptr_t)in;
+		out_buf = (uintptr_t)out;
+		if (dec->decompress(&in_buf, in_len, &out_buf, ref_len - 1U,
+				    (uintptr_t)work_buf, WORK_BUF_SIZE) == 0) {
+			printf("%s: output buffer too small: FAIL\n",
+			       filename);
+			ret = -1;
+		}
+	}
+
+	return ret;
+}
+
+/* Return the time taken to decompress 'in' 'iterations' times */
+static double time_decompress(const decompressor_t *dec, const uint8_t *in,
+			      size_t in_len, uint8_t *out, size_t ref_len,
+			      unsigned long iterations)
+{
+	uintptr_t in_buf, out_buf;
+	unsigned long i;
+	double start;
+
+	start = now();
+	for (i = 0U; i < iterations; i++) {
+		in_buf = (uintptr_t)in;
+		out_buf = (uintptr_t)out;
+		(void)dec->decompress(&in_buf, in_len, &out_buf, ref_len,
+				      (uintptr_t)work_buf, WORK_BUF_SIZE);
+	}
+
+	return now() - start;
+}
+
+static void bench(const char *filename, const decompressor_t *dec,
+		  const uint8_t *in, size_t in_len, uint8_t *out,
+		  size_t ref_len)
+{
+	unsigned long iterations = 1U;
+	double time, best;
+	int run;
+
+	/* Find a number of iterations that takes at least BENCH_MIN_TIME */
+	while ((best = time_decompress(dec, in, in_len, out, ref_len,
+				       iterations)) < BENCH_MIN_TIME)
+		iterations *= 2U;
+
+	for (run = 1; run < BENCH_RUNS; run++) {
+		time = time_decompress(dec, in, in_len, out, ref_len,
+				       iterations);
+		if (time < best)
+			best = time;
+	}
+
+	printf("%-32s %-5s %9zu -> %9zu  %8.1f MB/s\n", filename, dec->name,
+	       in_len, ref_len, (double)ref_len * iterations / best / 1e6);
+}
+
+static void usage(void)
+{
+	printf("usage: decompress_bench <compressed image> <original image> "
+	       "[<compressed image> <original image>...]\n\n");
+	printf("Checks that each compressed image decompresses to the original "
+	       "image, then\nmeasures the decompression speed in MB of "
+	       "output per second.\n");
+}
+
+int main(int argc, char *argv[])
+{
+	const decompressor_t *dec;
+	uint8_t *in, *ref, *out;
+	size_t in_len, ref_len;
+	int i, ret = 0;
+
+	if ((argc < 3) || ((argc % 2) == 0)) {
+		usage();
+		return 1;
+	}
+
+	work_buf = malloc(WORK_BUF_SIZE);
+	if (work_buf == NULL) {
+		fprintf(stderr, "out of memory\n");
+		return 1;
+	}
+
+	for (i = 1; i < argc; i += 2) {
+		in = read_file(argv[i], &in_len);
+		ref = read_file(argv[i + 1], &ref_len);
+		out = malloc(ref_len + 1U);
+		if ((in == NULL) || (ref == NULL) || (out == NULL)) {
+			ret = 1;
+			goto next;
+		}
+
+		dec = find_decompressor(in, in_len);
+		if (dec == NULL) {
+			fprintf(stderr, "%s: unknown compression format\n",
+				argv[i]);
+			ret = 1;
+			goto next;
+		}
+
+		if (check(argv[i], dec, in, in_len, out, ref, ref_len) != 0) {
+			ret = 1;
+			goto next;
+		}
+
+		bench(argv[i], dec, in, in_len, out, ref_len);
+next:
+		free(in);
+		free(ref);
+		free(out);
+	}
+
+	free(work_buf);
+
+	return ret;
+}
@@ -0,0 +1,24 @@
+/*
+ * Copyright (c) 2018, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef __DEBUG_H__
+#define __DEBUG_H__
+
+#include <stdio.h>
+
+/*
+ * Host replacement of the TF debug.h for the decompression libraries. Errors
+ * are expected while checking that bad input is rejected, so they are only
+ * printed in debug builds.
+ */
+#ifdef DEBUG
+#define ERROR(...)	fprintf(stderr, __VA_ARGS__)
+#else
+#define ERROR(...)
+#endif
+#define VERBOSE(...)
+
+#endif /* __DEBUG_H__ */
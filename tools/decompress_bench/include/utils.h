@@ -0,0 +1,16 @@
+/*
+ * Copyright (c) 2018, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef __UTILS_H__
+#define __UTILS_H__
+
+#include <stdint.h>
+
+/* Host replacement of the TF utils.h for the decompression libraries */
+#define round_up(value, boundary)					\
+	(((value) + (boundary) - 1) & ~((uintptr_t)(boundary) - 1))
+
+#endif /* __UTILS_H__ */
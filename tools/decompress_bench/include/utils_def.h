@@ -0,0 +1,13 @@
+/*
+ * Copyright (c) 2018, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef __UTILS_DEF_H__
+#define __UTILS_DEF_H__
+
+/* Host replacement of the TF utils_def.h for the decompression libraries */
+#define MIN(x, y)	((x) < (y) ? (x) : (y))
+
+#endif /* __UTILS_DEF_H__ */
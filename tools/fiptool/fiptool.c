@@ -17,6 +17,7 @@
 #include <string.h>
 
 #include "fiptool.h"
+#include "lz4_compress.h"
 #include "tbbr_config.h"
 
 #define OPT_TOC_ENTRY 0
@@ -33,6 +34,8 @@ static int unpack_cmd(int argc, char *argv[]);
 static void unpack_usage(void);
 static int remove_cmd(int argc, char *argv[]);
 static void remove_usage(void);
+static int compress_cmd(int argc, char *argv[]);
+static void compress_usage(void);
 static int version_cmd(int argc, char *argv[]);
 static void version_usage(void);
 static int help_cmd(int argc, char *argv[]);
@@ -45,6 +48,7 @@ static cmd_t cmds[] = {
 	{ .name = "update",  .handler = update_cmd,  .usage = update_usage  },
 	{ .name = "unpack",  .handler = unpack_cmd,  .usage = unpack_usage  },
 	{ .name = "remove",  .handler = remove_cmd,  .usage = remove_usage  },
+	{ .name = "compress", .handler = compress_cmd, .usage = compress_usage },
 	{ .name = "version", .handler = version_cmd, .usage = version_usage },
 	{ .name = "help",    .handler = help_cmd,    .usage = NULL          },
 };
@@ -1129,6 +1133,99 @@ static void remove_usage(void)
 	exit(1);
 }
 
+static int compress_cmd(int argc, char *argv[])
+{
+	struct option *opts = NULL;
+	size_t nr_opts = 0;
+	char outfile[PATH_MAX] = { 0 };
+	struct BLD_PLAT_STAT st;
+	unsigned char *buf, *lz4_buf;
+	size_t lz4_size;
+	FILE *fp;
+	int fflag = 0;
+
+	if (argc < 2)
+		compress_usage();
+
+	opts = add_opt(opts, &nr_opts, "force", no_argument, 'f');
+	opts = add_opt(opts, &nr_opts, "out", required_argument, 'o');
+	opts = add_opt(opts, &nr_opts, NULL, 0, 0);
+
+	while (1) {
+		int c, opt_index = 0;
+
+		c = getopt_long(argc, argv, "fo:", opts, &opt_index);
+		if (c == -1)
+			break;
+
+		switch (c) {
+		case 'f':
+			fflag = 1;
+			break;
+		case 'o':
+			snprintf(outfile, sizeof(outfile), "%s", optarg);
+			break;
+		default:
+			compress_usage();
+		}
+	}
+	argc -= optind;
+	argv += optind;
+	free(opts);
+
+	if (argc == 0)
+		compress_usage();
+
+	if (outfile[0] == '\0')
+		snprintf(outfile, sizeof(outfile), "%s.lz4", argv[0]);
+
+	if (access(outfile, F_OK) == 0 && !fflag)
+		log_errx("File %s already exists, use --force to overwrite it",
+		    outfile);
+
+	fp = fopen(argv[0], "rb");
+	if (fp == NULL)
+		log_err("fopen %s", argv[0]);
+
+	if (fstat(fileno(fp), &st) == -1)
+		log_errx("fstat %s", argv[0]);
+
+	buf = xmalloc(st.st_size + 1, "failed to allocate image buffer");
+	if (fread(buf, 1, st.st_size, fp) != st.st_size)
+		log_errx("Failed to read %s", argv[0]);
+	fclose(fp);
+
+	lz4_buf = xmalloc(lz4_compress_bound(st.st_size),
+	    "failed to allocate compression buffer");
+	lz4_size = lz4_compress(buf, st.st_size, lz4_buf);
+	if (verbose)
+		log_dbgx("Compressed %s: %lu -> %lu bytes", argv[0],
+		    (unsigned long)st.st_size, (unsigned long)lz4_size);
+
+	fp = fopen(outfile, "wb");
+	if (fp == NULL)
+		log_err("fopen %s", outfile);
+	xfwrite(lz4_buf, lz4_size, fp, outfile);
+	fclose(fp);
+
+	free(lz4_buf);
+	free(buf);
+	return 0;
+}
+
+static void compress_usage(void)
+{
+	printf("fiptool compress [opts] FILENAME\n");
+	printf("\n");
+	printf("Options:\n");
+	printf("  --force\t\tIf the output file already exists, use --force to overwrite it.\n");
+	printf("  --out FILENAME\tSet an alternative output file (default: FILENAME.lz4).\n");
+	printf("\n");
+	printf("The image is compressed to the LZ4 frame format, which can be decompressed\n");
+	printf("by the firmware with lib/lz4.\n");
+	exit(1);
+}
+
 static int version_cmd(int argc, char *argv[])
 {
 #ifdef VERSION
@@ -1176,6 +1273,7 @@ static void usage(void)
 	printf("  update\tUpdate an existing FIP with the given images.\n");
 	printf("  unpack\tUnpack images from FIP.\n");
 	printf("  remove\tRemove images from FIP.\n");
+	printf("  compress\tCompress an image to the LZ4 frame format.\n");
 	printf("  version\tShow fiptool version.\n");
 	printf("  help\t\tShow help for given command.\n");
 	exit(1);
@@ -0,0 +1,277 @@
+/*
+ * Copyright (c) 2018, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "lz4_compress.h"
+
+/*
+ * LZ4 frame compressor. The frame records the content size and a checksum of
+ * the content, and is made of linked blocks of at most 64KB, so matches can
+ * refer to the previous blocks. Matches are searched with hash chains, as the
+ * compression ratio matters more than the speed of the tool. The output can be
+ * decompressed by lib/lz4 as well as by the lz4 command line tool.
+ */
+
+#define LZ4_FRAME_MAGIC		0x184D2204U
+/* Version 01, linked blocks, content size and content checksum */
+#define LZ4_FRAME_FLG		0x4CU
+/* 64KB maximum block size */
+#define LZ4_FRAME_BD		0x40U
+#define LZ4_BLOCK_MAX		0x10000U
+#define LZ4_BLOCK_UNCOMPRESSED	0x80000000U
+
+#define MIN_MATCH		4U
+/* The last 5 bytes of a block are literals */
+#define LAST_LITERALS		5U
+/* The last match starts at least 12 bytes before the end of the block */
+#define MF_LIMIT		12U
+#define MAX_DISTANCE		0xFFFFU
+
+#define HASH_BITS		16U
+#define HASH_SIZE		(1U << HASH_BITS)
+/* Number of candidates examined for each match */
+#define MAX_CHAIN		256U
+
+#define XXH_PRIME32_1		0x9E3779B1U
+#define XXH_PRIME32_2		0x85EBCA77U
+#define XXH_PRIME32_3		0xC2B2AE3DU
+#define XXH_PRIME32_4		0x27D4EB2FU
+#define XXH_PRIME32_5		0x165667B1U
+
+#define ROTL32(x, n)		(((x) << (n)) | ((x) >> (32U - (n))))
+
+#define NO_POS			((size_t)-1)
+
+static size_t hash_head[HASH_SIZE];
+static size_t hash_prev[MAX_DISTANCE + 1U];
+static uint8_t block_buf[LZ4_BLOCK_MAX + (LZ4_BLOCK_MAX / 255U) + 16U];
+
+static uint32_t read_le32(const uint8_t *p)
+{
+	return (uint32_t)p[0] | ((uint32_t)p[1] << 8) |
+	       ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static uint8_t *write_le32(uint8_t *p, uint32_t v)
+{
+	p[0] = v & 0xFFU;
+	p[1] = (v >> 8) & 0xFFU;
+	p[2] = (v >> 16) & 0xFFU;
+	p[3] = (v >> 24) & 0xFFU;
+	return p + 4;
+}
+
+static uint32_t xxh32_round(uint32_t acc, uint32_t input)
+{
+	acc += input * XXH_PRIME32_2;
+	acc = ROTL32(acc, 13U);
+	return acc * XXH_PRIME32_1;
+}
+
+/* XXH32 hash with a seed of 0 */
+static uint32_t xxh32(const uint8_t *p, size_t len)
+{
+	const uint8_t *end = p + len;
+	uint32_t h;
+
+	if (len >= 16U) {
+		uint32_t v1 = XXH_PRIME32_1 + XXH_PRIME32_2;
+		uint32_t v2 = XXH_PRIME32_2;
+		uint32_t v3 = 0U;
+		uint32_t v4 = 0U - XXH_PRIME32_1;
+
+		do {
+			v1 = xxh32_round(v1, read_le32(p));
+			v2 = xxh32_round(v2, read_le32(p + 4));
+			v3 = xxh32_round(v3, read_le32(p + 8));
+			v4 = xxh32_round(v4, read_le32(p + 12));
+			p += 16;
+		} while ((size_t)(end - p) >= 16U);
+
+		h = ROTL32(v1, 1U) + ROTL32(v2, 7U) +
+		    ROTL32(v3, 12U) + ROTL32(v4, 18U);
+	} else {
+		h = XXH_PRIME32_5;
+	}
+
+	h += (uint32_t)len;
+
+	while ((size_t)(end - p) >= 4U) {
+		h += read_le32(p) * XXH_PRIME32_3;
+		h = ROTL32(h, 17U) * XXH_PRIME32_4;
+		p += 4;
+	}
+
+	while (p < end) {
+		h += (uint32_t)(*p++) * XXH_PRIME32_5;
+		h = ROTL32(h, 11U) * XXH_PRIME32_1;
+	}
+
+	h ^= h >> 15;
+	h *= XXH_PRIME32_2;
+	h ^= h >> 13;
+	h *= XXH_PRIME32_3;
+	h ^= h >> 16;
+
+	return h;
+}
+
+static uint32_t hash4(const uint8_t *p)
+{
+	return (read_le32(p) * 2654435761U) >> (32U - HASH_BITS);
+}
+
+/* Insert the position 'pos' of 'src' in the hash chains */
+static void insert_pos(const uint8_t *src, size_t pos)
+{
+	uint32_t h = hash4(src + pos);
+
+	hash_prev[pos & MAX_DISTANCE] = hash_head[h];
+	hash_head[h] = pos;
+}
+
+/* Encode a literal or match length extension */
+static uint8_t *write_length(uint8_t *p, size_t len)
+{
+	while (len >= 255U) {
+		*p++ = 255U;
+		len -= 255U;
+	}
+	*p++ = (uint8_t)len;
+	return p;
+}
+
+static uint8_t *write_sequence(uint8_t *p, const uint8_t *lit, size_t lit_len,
+			       size_t offset, size_t match_len)
+{
+	uint8_t *token = p++;
+
+	*token = (uint8_t)(((lit_len < 15U) ? lit_len : 15U) << 4);
+	if (lit_len >= 15U)
+		p = write_length(p, lit_len - 15U);
+	memcpy(p, lit, lit_len);
+	p += lit_len;
+
+	if (match_len == 0U)
+		return p;
+
+	*p++ = offset & 0xFFU;
+	*p++ = (offset >> 8) & 0xFFU;
+	match_len -= MIN_MATCH;
+	*token |= (uint8_t)((match_len < 15U) ? match_len : 15U);
+	if (match_len >= 15U)
+		p = write_length(p, match_len - 15U);
+
+	return p;
+}
+
+/*
+ * Compress the block of 'src' from 'start' to 'end' into block_buf. The bytes
+ * of 'src' before 'start' are the history. Return the size of the block.
+ */
+static size_t compress_block(const uint8_t *src, size_t start, size_t end)
+{
+	uint8_t *p = block_buf;
+	size_t anchor = start;
+	size_t pos = start;
+
+	while ((end - start >= MF_LIMIT + 1U) && (pos + MF_LIMIT <= end)) {
+		size_t match_limit = end - LAST_LITERALS;
+		size_t best_len = 0U, best_pos = 0U;
+		size_t cand = hash_head[hash4(src + pos)];
+		unsigned int chain = MAX_CHAIN;
+
+		while ((cand != NO_POS) && (pos - cand <= MAX_DISTANCE) &&
+		       (chain-- != 0U)) {
+			size_t len = 0U;
+
+			if (src[cand + best_len] == src[pos + best_len]) {
+				while ((pos + len < match_limit) &&
+				       (src[cand + len] == src[pos + len]))
+					len++;
+				if (len > best_len) {
+					best_len = len;
+					best_pos = cand;
+				}
+			}
+
+			if (hash_prev[cand & MAX_DISTANCE] >= cand)
+				break;
+			cand = hash_prev[cand & MAX_DISTANCE];
+		}
+
+		if (best_len < MIN_MATCH) {
+			insert_pos(src, pos++);
+			continue;
+		}
+
+		p = write_sequence(p, src + anchor, pos - anchor,
+				   pos - best_pos, best_len);
+		while (best_len-- != 0U)
+			insert_pos(src, pos++);
+		anchor = pos;
+	}
+
+	/* Insert the remaining positions for the matches of the next block */
+	for (; pos + MIN_MATCH <= end; pos++)
+		insert_pos(src, pos);
+
+	p = write_sequence(p, src + anchor, end - anchor, 0U, 0U);
+
+	return (size_t)(p - block_buf);
+}
+
+size_t lz4_compress_bound(size_t len)
+{
+	size_t blocks = (len + LZ4_BLOCK_MAX - 1U) / LZ4_BLOCK_MAX;
+
+	/* Header, blocks with their size, end mark and content checksum */
+	return 15U + len + (4U * blocks) + 8U;
+}
+
+size_t lz4_compress(const void *src, size_t len, void *dst)
+{
+	const uint8_t *in = src;
+	uint8_t *out = dst;
+	size_t start, end, size;
+	unsigned int i;
+
+	for (i = 0U; i < HASH_SIZE; i++)
+		hash_head[i] = NO_POS;
+
+	out = write_le32(out, LZ4_FRAME_MAGIC);
+	out[0] = LZ4_FRAME_FLG;
+	out[1] = LZ4_FRAME_BD;
+	write_le32(&out[2], (uint32_t)len);
+	write_le32(&out[6], (uint32_t)((uint64_t)len >> 32));
+	out[10] = (xxh32(out, 10U) >> 8) & 0xFFU;
+	out += 11;
+
+	for (start = 0U; start < len; start = end) {
+		end = start + LZ4_BLOCK_MAX;
+		if (end > len)
+			end = len;
+
+		size = compress_block(in, start, end);
+		if (size < end - start) {
+			out = write_le32(out, (uint32_t)size);
+			memcpy(out, block_buf, size);
+			out += size;
+		} else {
+			out = write_le32(out, (uint32_t)(end - start) |
+					 LZ4_BLOCK_UNCOMPRESSED);
+			memcpy(out, in + start, end - start);
+			out += end - start;
+		}
+	}
+
+	out = write_le32(out, 0U);
+	out = write_le32(out, xxh32(in, len));
+
+	return (size_t)(out - (uint8_t *)dst);
+}
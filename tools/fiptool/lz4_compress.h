@@ -0,0 +1,21 @@
+/*
+ * Copyright (c) 2018, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef __LZ4_COMPRESS_H__
+#define __LZ4_COMPRESS_H__
+
+#include <stddef.h>
+
+/* Upper bound of the size of an LZ4 frame holding 'len' bytes */
+size_t lz4_compress_bound(size_t len);
+
+/*
+ * Compress 'len' bytes from 'src' to an LZ4 frame at 'dst', which must hold at
+ * least lz4_compress_bound(len) bytes. Return the size of the frame.
+ */
+size_t lz4_compress(const void *src, size_t len, void *dst);
+
+#endif /* __LZ4_COMPRESS_H__ */
@@ -0,0 +1,454 @@
+/*
+ * Copyright (c) 2018, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <time.h>
+#include <unistd.h>
+
+/*
+ * Host checker and benchmark of the string functions of lib/libc. Each
+ * function is compared with a byte loop for every length up to MAX_LEN and
+ * every source and destination alignment, then both are timed. The lib/libc
+ * functions are built with a "tf_" prefix so that they can be called next to
+ * those of the host C library.
+ */
+
+/* Longest length checked, above the thresholds of the assembly routines */
+#define MAX_LEN			300U
+/* Alignments checked, for the source and the destination */
+#define MAX_ALIGN		16U
+/* Bytes around the destination that must not be written */
+#define GUARD_LEN		16U
+#define GUARD_BYTE		0xE7U
+/* Largest offset between the overlapping areas given to memmove() */
+#define MAX_OVERLAP		40U
+
+#define BUF_SIZE		(MAX_LEN + MAX_ALIGN + (2U * GUARD_LEN) + \
+				 MAX_OVERLAP)
+
+/* Minimum duration of a timed run, in seconds */
+#define BENCH_MIN_TIME		0.05
+/* Number of timed runs, the fastest one is reported */
+#define BENCH_RUNS		3
+#define BENCH_BUF_SIZE		(64U << 10)
+
+void *tf_memcpy(void *dst, const void *src, size_t len);
+void *tf_memset(void *dst, int val, size_t len);
+void *tf_memmove(void *dst, const void *src, size_t len);
+int tf_memcmp(const void *s1, const void *s2, size_t len);
+
+/* Byte loops the lib/libc functions are compared with */
+static __attribute__((noinline)) void *ref_memcpy(void *dst, const void *src,
+						  size_t len)
+{
+	const uint8_t *s = src;
+	uint8_t *d = dst;
+
+	while (len-- != 0U)
+		*d++ = *s++;
+
+	return dst;
+}
+
+static __attribute__((noinline)) void *ref_memset(void *dst, int val,
+						  size_t len)
+{
+	uint8_t *d = dst;
+
+	while (len-- != 0U)
+		*d++ = (uint8_t)val;
+
+	return dst;
+}
+
+static __attribute__((noinline)) void *ref_memmove(void *dst, const void *src,
+						   size_t len)
+{
+	const uint8_t *s = src;
+	uint8_t *d = dst;
+
+	if ((size_t)(d - s) >= len) {
+		while (len-- != 0U)
+			*d++ = *s++;
+	} else {
+		while (len-- != 0U)
+			d[len] = s[len];
+	}
+
+	return dst;
+}
+
+static __attribute__((noinline)) int ref_memcmp(const void *s1, const void *s2,
+						size_t len)
+{
+	const uint8_t *a = s1;
+	const uint8_t *b = s2;
+
+	for (; len != 0U; len--, a++, b++) {
+		if (*a != *b)
+			return *a - *b;
+	}
+
+	return 0;
+}
+
+#if !LIBC_BENCH_ASM
+/*
+ * Without the assembly routines of the host architecture, memmove() still
+ * needs a memcpy(). memcpy() and memset() are not checked then.
+ */
+void *tf_memcpy(void *dst, const void *src, size_t len)
+{
+	return ref_memcpy(dst, src, len);
+}
+
+void *tf_memset(void *dst, int val, size_t len)
+{
+	return ref_memset(dst, val, len);
+}
+#endif
+
+static uint8_t buf_a[BUF_SIZE];
+static uint8_t buf_b[BUF_SIZE];
+static uint8_t buf_ref[BUF_SIZE];
+
+static void fill(uint8_t *buf, size_t len, unsigned int seed)
+{
+	size_t i;
+
+	for (i = 0U; i < len; i++)
+		buf[i] = (uint8_t)((i * 167U) + (seed * 13U) + 1U);
+}
+
+static int fail(const char *func, size_t len, size_t off1, size_t off2)
+{
+	printf("%s: length %zu, offsets %zu and %zu: FAIL\n", func, len, off1,
+	       off2);
+
+	return -1;
+}
+
+/*
+ * Copy 'len' bytes from 'src' with memcpy() to every destination alignment,
+ * and check that exactly these bytes are written.
+ */
+static int check_memcpy_to(const uint8_t *src, size_t len, size_t src_off)
+{
+	uint8_t *dst;
+	size_t dst_off;
+
+	for (dst_off = 0U; dst_off < MAX_ALIGN; dst_off++) {
+		memset(buf_b, GUARD_BYTE, BUF_SIZE);
+		memset(buf_ref, GUARD_BYTE, BUF_SIZE);
+		dst = buf_b + GUARD_LEN + dst_off;
+		memcpy(buf_ref + GUARD_LEN + dst_off, src, len);
+
+		if ((tf_memcpy(dst, src, len) != dst) ||
+		    (memcmp(buf_b, buf_ref, BUF_SIZE) != 0))
+			return fail("memcpy", len, src_off, dst_off);
+	}
+
+	return 0;
+}
+
+/*
+ * memcpy() must only read the aligned words that hold source bytes, so it is
+ * also checked with sources that end or start at a page next to an
+ * inaccessible page.
+ */
+static int check_memcpy(void)
+{
+	long page_size = sysconf(_SC_PAGESIZE);
+	uint8_t *pages, *src;
+	size_t len, src_off;
+	int ret = 0;
+
+	for (len = 0U; len <= MAX_LEN; len++) {
+		for (src_off = 0U; src_off < MAX_ALIGN; src_off++) {
+			fill(buf_a, BUF_SIZE, len);
+			if (check_memcpy_to(buf_a + src_off, len, src_off))
+				ret = -1;
+		}
+	}
+
+	pages = mmap(NULL, 3 * page_size, PROT_READ | PROT_WRITE,
+		     MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if ((pages == MAP_FAILED) ||
+	    (mprotect(pages, page_size, PROT_NONE) != 0) ||
+	    (mprotect(pages + (2 * page_size), page_size, PROT_NONE) != 0)) {
+		perror("memcpy");
+		return -1;
+	}
+
+	for (len = 0U; len <= MAX_LEN; len++) {
+		fill(pages + page_size, page_size, len);
+		src = pages + (2 * page_size) - len;
+		if (check_memcpy_to(src, len, (uintptr_t)src % MAX_ALIGN))
+			ret = -1;
+		src = pages + page_size;
+		if (check_memcpy_to(src, len, 0U))
+			ret = -1;
+	}
+
+	munmap(pages, 3 * page_size);
+
+	return ret;
+}
+
+static int check_memset(void)
+{
+	static const int vals[] = { 0x00, 0x5A, 0x80, 0xFF, 0x1234 };
+	size_t len, dst_off, i;
+	uint8_t *dst;
+	int ret = 0;
+
+	for (i = 0U; i < sizeof(vals) / sizeof(vals[0]); i++) {
+		for (len = 0U; len <= MAX_LEN; len++) {
+			for (dst_off = 0U; dst_off < MAX_ALIGN; dst_off++) {
+				memset(buf_b, GUARD_BYTE, BUF_SIZE);
+				memset(buf_ref, GUARD_BYTE, BUF_SIZE);
+				dst = buf_b + GUARD_LEN + dst_off;
+				ref_memset(buf_ref + GUARD_LEN + dst_off,
+					   vals[i], len);
+
+				if ((tf_memset(dst, vals[i], len) != dst) ||
+				    (memcmp(buf_b, buf_ref, BUF_SIZE) != 0)) {
+					ret = -1;
+					printf("memset: length %zu, offset %zu, "
+					       "value 0x%x: FAIL\n", len, dst_off,
+					       vals[i]);
+				}
+			}
+		}
+	}
+
+	return ret;
+}
+
+/* Move data within one buffer, with every overlap in both directions */
+static int check_memmove(void)
+{
+	size_t len, src_off, dst_off;
+	uint8_t *base;
+	int ret = 0;
+
+	for (len = 0U; len <= MAX_LEN; len++) {
+		for (src_off = 0U; src_off <= MAX_OVERLAP; src_off++) {
+			for (dst_off = 0U; dst_off <= MAX_OVERLAP; dst_off++) {
+				fill(buf_b, BUF_SIZE, len);
+				fill(buf_ref, BUF_SIZE, len);
+				base = buf_b + GUARD_LEN;
+				ref_memmove(buf_ref + GUARD_LEN + dst_off,
+					    buf_ref + GUARD_LEN + src_off, len);
+
+				if ((tf_memmove(base + dst_off, base + src_off,
+						len) != base + dst_off) ||
+				    (memcmp(buf_b, buf_ref, BUF_SIZE) != 0))
+					ret = fail("memmove", len, src_off,
+						   dst_off);
+			}
+		}
+	}
+
+	return ret;
+}
+
+static int same_sign(int a, int b)
+{
+	return ((a < 0) == (b < 0)) && ((a > 0) == (b > 0));
+}
+
+/*
+ * Compare equal buffers, then buffers that differ at one position. Lengths
+ * above 64 bytes are only changed at every 7th position and the last one.
+ */
+static int check_memcmp(void)
+{
+	size_t len, off1, off2, pos;
+	uint8_t *s1, *s2;
+	int ret = 0;
+
+	for (len = 0U; len <= MAX_LEN; len++) {
+		for (off1 = 0U; off1 < MAX_ALIGN; off1++) {
+			for (off2 = 0U; off2 < MAX_ALIGN; off2++) {
+				s1 = buf_a + off1;
+				s2 = buf_b + off2;
+				fill(s1, len, len);
+				fill(s2, len, len);
+				if (tf_memcmp(s1, s2, len) != 0)
+					ret = fail("memcmp", len, off1, off2);
+
+				for (pos = 0U; pos < len;
+				     pos += (len <= 64U) ? 1U : 7U) {
+					s1[pos] = 0x80U;
+					s2[pos] = 0x7FU;
+					if (!same_sign(tf_memcmp(s1, s2, len),
+						       ref_memcmp(s1, s2, len)) ||
+					    !same_sign(tf_memcmp(s2, s1, len),
+						       ref_memcmp(s2, s1, len)))
+						ret = fail("memcmp", len, off1,
+							   off2);
+					fill(s1, len, len);
+					fill(s2, len, len);
+				}
+
+				if (len != 0U) {
+					s2[len - 1U] ^= 1U;
+					if (!same_sign(tf_memcmp(s1, s2, len),
+						       ref_memcmp(s1, s2, len)))
+						ret = fail("memcmp", len, off1,
+							   off2);
+				}
+			}
+		}
+	}
+
+	return ret;
+}
+
+static double now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return (double)ts.tv_sec + ((double)ts.tv_nsec * 1e-9);
+}
+
+typedef enum {
+	FUNC_MEMCPY,
+	FUNC_MEMSET,
+	FUNC_MEMMOVE,
+	FUNC_MEMCMP
+} func_t;
+
+static const char *const func_names[] = {
+	[FUNC_MEMCPY] = "memcpy",
+	[FUNC_MEMSET] = "memset",
+	[FUNC_MEMMOVE] = "memmove",
+	[FUNC_MEMCMP] = "memcmp",
+};
+
+/* Return the time taken to call 'func' 'iterations' times on 'len' bytes */
+static double time_func(func_t func, int tf, uint8_t *dst, uint8_t *src,
+			size_t len, unsigned long iterations)
+{
+	unsigned long i;
+	double start;
+
+	start = now();
+	for (i = 0U; i < iterations; i++) {
+		switch (func) {
+		case FUNC_MEMCPY:
+			(void)(tf ? tf_memcpy : ref_memcpy)(dst, src, len);
+			break;
+		case FUNC_MEMSET:
+			(void)(tf ? tf_memset : ref_memset)(dst, 0, len);
+			break;
+		case FUNC_MEMMOVE:
+			(void)(tf ? tf_memmove : ref_memmove)(dst, src, len);
+			break;
+		default:
+			(void)(tf ? tf_memcmp : ref_memcmp)(dst, src, len);
+			break;
+		}
+	}
+
+	return now() - start;
+}
+
+/* Return the throughput of 'func' on 'len' bytes, in MB per second */
+static double bench_func(func_t func, int tf, uint8_t *dst, uint8_t *src,
+			 size_t len)
+{
+	unsigned long iterations = 1U;
+	double time, best;
+	int run;
+
+	/* Find a number of iterations that takes at least BENCH_MIN_TIME */
+	while ((best = time_func(func, tf, dst, src, len, iterations)) <
+	       BENCH_MIN_TIME)
+		iterations *= 2U;
+
+	for (run = 1; run < BENCH_RUNS; run++) {
+		time = time_func(func, tf, dst, src, len, iterations);
+		if (time < best)
+			best = time;
+	}
+
+	return (double)len * iterations / best / 1e6;
+}
+
+static void bench(func_t func)
+{
+	static const size_t lens[] = { 16, 256, 4096, 65536 - 128 };
+	uint8_t *buf, *dst, *src;
+	size_t i, off;
+
+	buf = malloc(2U * BENCH_BUF_SIZE);
+	if (buf == NULL) {
+		fprintf(stderr, "out of memory\n");
+		exit(1);
+	}
+
+	/*
+	 * Mutually aligned buffers, then a source misaligned by 3 bytes. Both
+	 * hold the same data, so memcmp() goes through the whole length.
+	 * memmove() is timed on overlapping areas, with a backward copy.
+	 */
+	for (off = 0U; off <= 3U; off += 3U) {
+		src = buf + off;
+		dst = (func == FUNC_MEMMOVE) ? buf + 64 : buf + BENCH_BUF_SIZE;
+		fill(src, BENCH_BUF_SIZE - 64U, 0U);
+		fill(buf + BENCH_BUF_SIZE, BENCH_BUF_SIZE, 0U);
+
+		for (i = 0U; i < sizeof(lens) / sizeof(lens[0]); i++) {
+			printf("%-8s %6zu bytes  %-10s %9.1f MB/s  "
+			       "byte loop %9.1f MB/s\n", func_names[func],
+			       lens[i], (off == 0U) ? "aligned" : "misaligned",
+			       bench_func(func, 1, dst, src, lens[i]),
+			       bench_func(func, 0, dst, src, lens[i]));
+		}
+	}
+
+	free(buf);
+}
+
+int main(void)
+{
+	int ret = 0;
+
+	if (LIBC_BENCH_ASM) {
+		if (check_memcpy() != 0)
+			ret = 1;
+		if (check_memset() != 0)
+			ret = 1;
+	} else {
+		printf("memcpy, memset: not checked, the host is neither "
+		       "AArch64 nor AArch32\n");
+	}
+
+	if (check_memmove() != 0)
+		ret = 1;
+	if (check_memcmp() != 0)
+		ret = 1;
+
+	if (ret != 0)
+		return ret;
+
+	if (LIBC_BENCH_ASM) {
+		bench(FUNC_MEMCPY);
+		bench(FUNC_MEMSET);
+	}
+	bench(FUNC_MEMMOVE);
+	bench(FUNC_MEMCMP);
+
+	return 0;
+}
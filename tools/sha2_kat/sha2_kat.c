@@ -0,0 +1,388 @@
+/*
+ * Copyright (c) 2018, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * Known-answer tests for the SHA-256, SHA-384 and SHA-512 compression
+ * functions used by the mbed TLS images of TF-A:
+ *
+ *  - the portable functions of mbed TLS, which mbedtls_sha_armv8.c falls back
+ *    to when the CPU does not implement the SHA-2 instructions, through both
+ *    their block interface and the mbed TLS hash API;
+ *  - sha256_block_armv8() and sha512_block_armv8(), when the host is an
+ *    AArch64 machine which implements the instructions they use.
+ *
+ * The messages and digests are the ones of the FIPS 180-4 examples. The
+ * assembly functions are also compared with the portable ones on
+ * pseudo-random multi-block data.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#if SHA2_KAT_ASM
+#include <sys/auxv.h>
+#endif
+
+#include <mbedtls/sha256.h>
+#include <mbedtls/sha512.h>
+
+typedef enum {
+	SHA256,
+	SHA384,
+	SHA512
+} sha_alg_t;
+
+typedef struct {
+	const char *msg;
+	unsigned int repeat;
+	const char *digest[3];		/* Indexed by sha_alg_t */
+} kat_t;
+
+/* FIPS 180-4 example messages */
+static const kat_t kats[] = {
+	{ "abc", 1U, {
+	  "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad",
+	  "cb00753f45a35e8bb5a03d699ac65007272c32ab0eded163"
+	  "1a8b605a43ff5bed8086072ba1e7cc2358baeca134c825a7",
+	  "ddaf35a193617abacc417349ae20413112e6fa4e89a97ea20a9eeee64b55d39a"
+	  "2192992a274fc1a836ba3c23a3feebbd454d4423643ce80e2a9ac94fa54ca49f" } },
+	{ "", 1U, {
+	  "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855",
+	  "38b060a751ac96384cd9327eb1b1e36a21fdb71114be0743"
+	  "4c0cc7bf63f6e1da274edebfe76f65fbd51ad2f14898b95b",
+	  "cf83e1357eefb8bdf1542850d66d8007d620e4050b5715dc83f4a921d36ce9ce"
+	  "47d0d13c5d85f2b0ff8318d2877eec2f63b931bd47417a81a538327af927da3e" } },
+	{ "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq", 1U, {
+	  "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1",
+	  "3391fdddfc8dc7393707a65b1b4709397cf8b1d162af05ab"
+	  "fe8f450de5f36bc6b0455a8520bc4e6f5fe95b1fe3c8452b",
+	  "204a8fc6dda82f0a0ced7beb8e08a41657c16ef468b228a8279be331a703c335"
+	  "96fd15c13b1b07f9aa1d3bea57789ca031ad85c7a71dd70354ec631238ca3445" } },
+	{ "abcdefghbcdefghicdefghijdefghijkefghijklfghijklmghijklmn"
+	  "hijklmnoijklmnopjklmnopqklmnopqrlmnopqrsmnopqrstnopqrstu", 1U, {
+	  "cf5b16a778af8380036ce59e7b0492370b249b11e8f07a51afac45037afee9d1",
+	  "09330c33f71147e83d192fc782cd1b4753111b173b3b05d2"
+	  "2fa08086e3b0f712fcc7c71a557e2db966c3e9fa91746039",
+	  "8e959b75dae313da8cf4f72814fc143f8f7779c6eb9f7fa17299aeadb6889018"
+	  "501d289e4900f7e4331b99dec4b5433ac7d329eeb6dd26545e96e55b874be909" } },
+	{ "a", 1000000U, {
+	  "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0",
+	  "9d0e1809716474cb086e834e310a4a1ced149e9c00f24852"
+	  "7972cec5704c2a5b07b8b3dc38ecc4ebae97ddd87f3d8985",
+	  "e718483d0ce769644e2e42c7bc15b4638e1f98b13b2044285632a803afa973eb"
+	  "de0ff244877ea60a4cb0432ce577c31beb009c5c2c49aa2e4eadb217ad8cc09b" } },
+};
+
+static const char *const alg_names[] = { "SHA-256", "SHA-384", "SHA-512" };
+static const size_t digest_sizes[] = { 32U, 48U, 64U };
+
+/* Chunk sizes of the incremental hashes through the mbed TLS API */
+static const size_t chunk_sizes[] = { 1U, 63U, 64U, 65U, 127U, 129U, 4096U };
+
+/* Compression functions of 'blocks' consecutive blocks */
+typedef void (*sha256_block_fn_t)(uint32_t state[8], const unsigned char *data,
+				  size_t blocks);
+typedef void (*sha512_block_fn_t)(uint64_t state[8], const unsigned char *data,
+				  size_t blocks);
+
+#if SHA2_KAT_ASM
+void sha256_block_armv8(uint32_t state[8], const unsigned char *data,
+			size_t blocks);
+void sha512_block_armv8(uint64_t state[8], const unsigned char *data,
+			size_t blocks);
+#endif
+
+static unsigned int failures;
+
+static void fail(const char *what, sha_alg_t alg, const char *msg,
+		 size_t len)
+{
+	printf("FAIL: %s %s, message \"%.16s%s\" of %zu bytes\n", what,
+	       alg_names[alg], msg, (strlen(msg) > 16U) ? "..." : "", len);
+	failures++;
+}
+
+static void to_hex(const unsigned char *data, size_t len, char *hex)
+{
+	for (size_t i = 0U; i < len; i++)
+		sprintf(&hex[2U * i], "%02x", data[i]);
+}
+
+static int check_digest(const unsigned char *digest, sha_alg_t alg,
+			const char *expected)
+{
+	char hex[129];
+
+	to_hex(digest, digest_sizes[alg], hex);
+
+	return strcmp(hex, expected);
+}
+
+/* Portable compression functions of mbed TLS */
+static void sha256_block_c(uint32_t state[8], const unsigned char *data,
+			   size_t blocks)
+{
+	mbedtls_sha256_context ctx;
+
+	mbedtls_sha256_init(&ctx);
+	memcpy(ctx.state, state, sizeof(ctx.state));
+	for (size_t i = 0U; i < blocks; i++)
+		mbedtls_internal_sha256_process(&ctx, &data[64U * i]);
+	memcpy(state, ctx.state, sizeof(ctx.state));
+	mbedtls_sha256_free(&ctx);
+}
+
+static void sha512_block_c(uint64_t state[8], const unsigned char *data,
+			   size_t blocks)
+{
+	mbedtls_sha512_context ctx;
+
+	mbedtls_sha512_init(&ctx);
+	memcpy(ctx.state, state, sizeof(ctx.state));
+	for (size_t i = 0U; i < blocks; i++)
+		mbedtls_internal_sha512_process(&ctx, &data[128U * i]);
+	memcpy(state, ctx.state, sizeof(ctx.state));
+	mbedtls_sha512_free(&ctx);
+}
+
+/*
+ * Hash a message with a compression function, padding it as specified by
+ * FIPS 180-4.
+ */
+static void sha256_hash(sha256_block_fn_t block, const unsigned char *msg,
+			size_t len, unsigned char digest[32])
+{
+	uint32_t state[8] = {
+		0x6a09e667U, 0xbb67ae85U, 0x3c6ef372U, 0xa54ff53aU,
+		0x510e527fU, 0x9b05688cU, 0x1f83d9abU, 0x5be0cd19U
+	};
+	unsigned char last[128] = { 0 };
+	size_t full = len / 64U;
+	size_t rem = len % 64U;
+	size_t last_len = (rem < 56U) ? 64U : 128U;
+	uint64_t bits = (uint64_t)len * 8U;
+
+	if (full != 0U)
+		block(state, msg, full);
+
+	memcpy(last, &msg[64U * full], rem);
+	last[rem] = 0x80U;
+	for (unsigned int i = 0U; i < 8U; i++)
+		last[last_len - 1U - i] = (unsigned char)(bits >> (8U * i));
+	block(state, last, last_len / 64U);
+
+	for (unsigned int i = 0U; i < 32U; i++)
+		digest[i] = (unsigned char)(state[i / 4U] >> (24U - 8U * (i % 4U)));
+}
+
+static void sha512_hash(sha512_block_fn_t block, sha_alg_t alg,
+			const unsigned char *msg, size_t len,
+			unsigned char digest[64])
+{
+	static const uint64_t iv384[8] = {
+		0xcbbb9d5dc1059ed8ULL, 0x629a292a367cd507ULL,
+		0x9159015a3070dd17ULL, 0x152fecd8f70e5939ULL,
+		0x67332667ffc00b31ULL, 0x8eb44a8768581511ULL,
+		0xdb0c2e0d64f98fa7ULL, 0x47b5481dbefa4fa4ULL
+	};
+	static const uint64_t iv512[8] = {
+		0x6a09e667f3bcc908ULL, 0xbb67ae8584caa73bULL,
+		0x3c6ef372fe94f82bULL, 0xa54ff53a5f1d36f1ULL,
+		0x510e527fade682d1ULL, 0x9b05688c2b3e6c1fULL,
+		0x1f83d9abfb41bd6bULL, 0x5be0cd19137e2179ULL
+	};
+	uint64_t state[8];
+	unsigned char last[256] = { 0 };
+	size_t full = len / 128U;
+	size_t rem = len % 128U;
+	size_t last_len = (rem < 112U) ? 128U : 256U;
+	uint64_t bits = (uint64_t)len * 8U;
+
+	memcpy(state, (alg == SHA384) ? iv384 : iv512, sizeof(state));
+
+	if (full != 0U)
+		block(state, msg, full);
+
+	/* The upper 64 bits of the 128-bit length are always 0 here */
+	memcpy(last, &msg[128U * full], rem);
+	last[rem] = 0x80U;
+	for (unsigned int i = 0U; i < 8U; i++)
+		last[last_len - 1U - i] = (unsigned char)(bits >> (8U * i));
+	block(state, last, last_len / 128U);
+
+	for (unsigned int i = 0U; i < digest_sizes[alg]; i++)
+		digest[i] = (unsigned char)(state[i / 8U] >> (56U - 8U * (i % 8U)));
+}
+
+static void check_sha256_blocks(const char *what, sha256_block_fn_t block,
+				const kat_t *kat, const unsigned char *msg,
+				size_t len)
+{
+	unsigned char digest[32];
+
+	sha256_hash(block, msg, len, digest);
+	if (check_digest(digest, SHA256, kat->digest[SHA256]) != 0)
+		fail(what, SHA256, kat->msg, len);
+}
+
+static void check_sha512_blocks(const char *what, sha512_block_fn_t block,
+				const kat_t *kat, const unsigned char *msg,
+				size_t len)
+{
+	unsigned char digest[64];
+
+	for (sha_alg_t alg = SHA384; alg <= SHA512; alg++) {
+		sha512_hash(block, alg, msg, len, digest);
+		if (check_digest(digest, alg, kat->digest[alg]) != 0)
+			fail(what, alg, kat->msg, len);
+	}
+}
+
+/* Hash the message through the mbed TLS API, in chunks of every size */
+static void hash_mbedtls(const kat_t *kat, const unsigned char *msg,
+			 size_t len)
+{
+	mbedtls_sha256_context ctx256;
+	mbedtls_sha512_context ctx512;
+	unsigned char digest[64];
+	size_t i, n;
+
+	for (unsigned int c = 0U;
+	     c < sizeof(chunk_sizes) / sizeof(chunk_sizes[0]); c++) {
+		mbedtls_sha256_init(&ctx256);
+		mbedtls_sha256_starts_ret(&ctx256, 0);
+		for (i = 0U; i < len; i += n) {
+			n = (len - i < chunk_sizes[c]) ? len - i : chunk_sizes[c];
+			mbedtls_sha256_update_ret(&ctx256, &msg[i], n);
+		}
+		mbedtls_sha256_finish_ret(&ctx256, digest);
+		mbedtls_sha256_free(&ctx256);
+		if (check_digest(digest, SHA256, kat->digest[SHA256]) != 0)
+			fail("mbed TLS", SHA256, kat->msg, len);
+
+		for (sha_alg_t alg = SHA384; alg <= SHA512; alg++) {
+			mbedtls_sha512_init(&ctx512);
+			mbedtls_sha512_starts_ret(&ctx512, alg == SHA384);
+			for (i = 0U; i < len; i += n) {
+				n = (len - i < chunk_sizes[c]) ?
+				    len - i : chunk_sizes[c];
+				mbedtls_sha512_update_ret(&ctx512, &msg[i], n);
+			}
+			mbedtls_sha512_finish_ret(&ctx512, digest);
+			mbedtls_sha512_free(&ctx512);
+			if (check_digest(digest, alg, kat->digest[alg]) != 0)
+				fail("mbed TLS", alg, kat->msg, len);
+		}
+	}
+}
+
+#if SHA2_KAT_ASM
+/*
+ * Compare the state produced by the assembly functions with the one of the
+ * portable functions, for up to 16 blocks of pseudo-random data at once.
+ */
+static void compare_blocks(int has_sha512)
+{
+	static unsigned char data[16U * 128U];
+	uint32_t seed = 0x12345678U;
+	uint32_t s256_c[8], s256_asm[8];
+	uint64_t s512_c[8], s512_asm[8];
+
+	for (unsigned int iter = 0U; iter < 1000U; iter++) {
+		size_t blocks = (iter % 16U) + 1U;
+
+		for (size_t i = 0U; i < sizeof(data); i++) {
+			seed = (seed * 1103515245U) + 12345U;
+			data[i] = (unsigned char)(seed >> 16);
+		}
+		for (unsigned int i = 0U; i < 8U; i++) {
+			s256_c[i] = s256_asm[i] = seed ^ i;
+			s512_c[i] = s512_asm[i] = ((uint64_t)seed << 32) | i;
+		}
+
+		sha256_block_c(s256_c, data, blocks);
+		sha256_block_armv8(s256_asm, data, blocks);
+		if (memcmp(s256_c, s256_asm, sizeof(s256_c)) != 0) {
+			printf("FAIL: sha256_block_armv8() on %zu blocks\n",
+			       blocks);
+			failures++;
+		}
+
+		if (has_sha512 == 0)
+			continue;
+
+		sha512_block_c(s512_c, data, blocks);
+		sha512_block_armv8(s512_asm, data, blocks);
+		if (memcmp(s512_c, s512_asm, sizeof(s512_c)) != 0) {
+			printf("FAIL: sha512_block_armv8() on %zu blocks\n",
+			       blocks);
+			failures++;
+		}
+	}
+}
+#endif
+
+int main(void)
+{
+	unsigned char *msg;
+	size_t len;
+#if SHA2_KAT_ASM
+	unsigned long hwcap = getauxval(AT_HWCAP);
+	int has_sha256 = ((hwcap & HWCAP_SHA2) != 0U) ? 1 : 0;
+	int has_sha512 = ((hwcap & HWCAP_SHA512) != 0U) ? 1 : 0;
+
+	if (has_sha256 == 0)
+		printf("No SHA-256 instructions, sha256_block_armv8() not checked\n");
+	if (has_sha512 == 0)
+		printf("No SHA-512 instructions, sha512_block_armv8() not checked\n");
+#else
+	printf("Not an AArch64 host, the assembly functions are not checked\n");
+#endif
+
+	for (unsigned int k = 0U; k < sizeof(kats) / sizeof(kats[0]); k++) {
+		const kat_t *kat = &kats[k];
+		size_t msg_len = strlen(kat->msg);
+
+		len = msg_len * kat->repeat;
+		msg = malloc(len + 1U);
+		if (msg == NULL) {
+			printf("Out of memory\n");
+			return 1;
+		}
+		for (unsigned int r = 0U; r < kat->repeat; r++)
+			memcpy(&msg[r * msg_len], kat->msg, msg_len);
+
+		check_sha256_blocks("portable", sha256_block_c, kat, msg, len);
+		check_sha512_blocks("portable", sha512_block_c, kat, msg, len);
+		hash_mbedtls(kat, msg, len);
+#if SHA2_KAT_ASM
+		if (has_sha256 != 0) {
+			check_sha256_blocks("ARMv8", sha256_block_armv8, kat,
+					    msg, len);
+		}
+		if (has_sha512 != 0) {
+			check_sha512_blocks("ARMv8", sha512_block_armv8, kat,
+					    msg, len);
+		}
+#endif
+		free(msg);
+	}
+
+#if SHA2_KAT_ASM
+	if (has_sha256 != 0)
+		compare_blocks(has_sha512);
+#endif
+
+	if (failures != 0U) {
+		printf("%u checks failed\n", failures);
+		return 1;
+	}
+
+	printf("All checks passed\n");
+
+	return 0;
+}